@@ -225,6 +225,10 @@ int main(int argc, char *argv[])
     {
       Configuration conf(db_name);
 
+      // referenced-by information is printed for every object
+      if (referenced_by)
+        conf.set_references_index(true);
+
       // get versions if any
       if (changes)
         {
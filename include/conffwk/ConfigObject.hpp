@@ -198,6 +198,10 @@ class ConfigObject {
 
     void action_on_object_update(Configuration * db, const std::string& name);
 
+      // replace object read from database snapshot by the one of implementation plug-in before modification (see Configuration::leave_snapshot_cache(ConfigObject&))
+
+    ConfigObjectImpl * writable_impl();
+
 
 
   public:
@@ -214,7 +218,7 @@ class ConfigObject {
       *  allows to identify object inside database.
       */
 
-    const std::string& UID() const noexcept { return m_impl->m_id; }
+    const std::string& UID() const noexcept { return *m_impl->m_id_ptr; }
 
 
      /**
@@ -280,6 +284,76 @@ class ConfigObject {
     }
 
 
+     /**
+      *  \brief Get value of object's attribute using pre-resolved handle.
+      *
+      *  Same as above, but the attribute is given by handle made by the Configuration::get_attribute_handle()
+      *  for class of the object or for its superclass. Use it, when the same attribute is read for many objects.
+      *
+      *  \throw dunedaq::conffwk::Exception in case of an error
+      */
+
+    template<class T> void get(const AttributeHandle& attribute, T& value) {
+      m_impl->get(attribute, value);
+      m_impl->convert(value, *this, attribute.name());
+    }
+
+
+     /**
+      *  \brief Get value of object's attribute of any type using pre-resolved handle.
+      *
+      *  The value is read according to the type of attribute and converted.
+      *
+      *  \throw dunedaq::conffwk::Exception in case of an error
+      */
+
+    void get(const AttributeHandle& attribute, attribute_value_t& value);
+
+
+     /**
+      *  \brief Get value of object's relationship using pre-resolved handle.
+      *
+      *  The relationship is given by handle made by the Configuration::get_relationship_handle()
+      *  for class of the object or for its superclass.
+      *
+      *  \param relationship  the relationship handle
+      *  \param value         returned value of relationship (ConfigObject& or std::vector<ConfigObject>&)
+      *
+      *  \throw dunedaq::conffwk::Exception in case of an error
+      */
+
+    template<class T> void get(const RelationshipHandle& relationship, T& value) {
+      m_impl->get(relationship, value);
+    }
+
+
+     /**
+      *  \brief Get values of all object's attributes.
+      *
+      *  The values are read by single call of implementation and converted.
+      *  They are stored in order of attributes of object's class description
+      *  returned by Configuration::get_class_info(), including inherited attributes.
+      *
+      *  \param values  returned values of attributes
+      *
+      *  \throw dunedaq::conffwk::Exception in case of an error
+      */
+
+    void get_all(std::vector<attribute_value_t>& values);
+
+
+     /**
+      *  \brief Get values of all object's attributes using description of object's class.
+      *
+      *  Same as above, but the description is provided by caller, so the method does not need to get it from Configuration.
+      *  It has to be the description of object's class (including inherited attributes) returned by Configuration::get_class_info().
+      *
+      *  \throw dunedaq::conffwk::Exception in case of an error
+      */
+
+    void get_all(const class_t& description, std::vector<attribute_value_t>& values);
+
+
      /**
       *  \brief Get value of object's relationship.
       *
@@ -312,7 +386,7 @@ class ConfigObject {
       *  If the relationship name is set to "*", then the method takes into account  all relationships of all objects.
       *  The method is efficient only for composite relationships (i.e. when a parent has composite reference on this object).
       *  For generic relationships the method performs full scan of all database objects, so at large scale this method
-      *  should not be applied to every object.
+      *  should not be applied to every object, unless the index of references is enabled (see Configuration::set_references_index()).
       *
       *  \param value                 returned objects
       *  \param relationship_name     name of relationship (if "*", then return objects referencing via ANY relationship)
@@ -327,9 +401,7 @@ class ConfigObject {
 		       const std::string& relationship_name = "*",
 		       bool check_composite_only = true,
 		       unsigned long rlevel = 0,
-		       const std::vector<std::string> * rclasses = nullptr ) const {
-      m_impl->referenced_by(value, relationship_name, check_composite_only, rlevel, rclasses);
-    }
+		       const std::vector<std::string> * rclasses = nullptr ) const;
 
     /// Get pointer to configuration object
     Configuration * get_configuration() const;
@@ -345,10 +417,7 @@ class ConfigObject {
       *  \throw dunedaq::conffwk::Generic in case of an error
       */
 
-    void set_obj(const std::string& name, const ConfigObject * o, bool skip_non_null_check = false) {
-      m_impl->set(name, o, skip_non_null_check);
-      action_on_object_update(get_configuration(), name);
-    }
+    void set_obj(const std::string& name, const ConfigObject * o, bool skip_non_null_check = false);
 
 
      /**
@@ -361,10 +430,7 @@ class ConfigObject {
       *  \throw dunedaq::conffwk::Generic in case of an error
       */
 
-    void set_objs(const std::string& name, const std::vector<const ConfigObject*> & o, bool skip_non_null_check = false) {
-      m_impl->set(name, o, skip_non_null_check);
-      action_on_object_update(get_configuration(), name);
-    }
+    void set_objs(const std::string& name, const std::vector<const ConfigObject*> & o, bool skip_non_null_check = false);
 
 
      /**
@@ -388,7 +454,7 @@ class ConfigObject {
       */
 
     template<class T> void set_by_val(const std::string& name, T value) {
-      m_impl->set(name, value);
+      writable_impl()->set(name, value);
       action_on_object_update(get_configuration(), name);
     }
 
@@ -409,7 +475,7 @@ class ConfigObject {
       */
 
     template<class T> void set_by_ref(const std::string& name, T& value) {
-      m_impl->set(name, value);
+      writable_impl()->set(name, value);
       action_on_object_update(get_configuration(), name);
     }
 
@@ -426,7 +492,7 @@ class ConfigObject {
       */
 
     void set_enum(const std::string& name, const std::string& value) {
-      m_impl->set_enum(name, value);
+      writable_impl()->set_enum(name, value);
       action_on_object_update(get_configuration(), name);
     }
 
@@ -443,7 +509,7 @@ class ConfigObject {
       */
 
     void set_class(const std::string& name, const std::string& value) {
-      m_impl->set_class(name, value);
+      writable_impl()->set_class(name, value);
       action_on_object_update(get_configuration(), name);
     }
 
@@ -460,7 +526,7 @@ class ConfigObject {
       */
 
     void set_date(const std::string& name, const std::string& value) {
-      m_impl->set_date(name, value);
+      writable_impl()->set_date(name, value);
       action_on_object_update(get_configuration(), name);
     }
 
@@ -477,7 +543,7 @@ class ConfigObject {
       */
 
     void set_time(const std::string& name, const std::string& value) {
-      m_impl->set_time(name, value);
+      writable_impl()->set_time(name, value);
       action_on_object_update(get_configuration(), name);
     }
 
@@ -494,7 +560,7 @@ class ConfigObject {
       */
 
     void set_enum(const std::string& name, const std::vector<std::string>& value) {
-      m_impl->set_enum(name, value);
+      writable_impl()->set_enum(name, value);
       action_on_object_update(get_configuration(), name);
     }
 
@@ -511,7 +577,7 @@ class ConfigObject {
       */
 
     void set_class(const std::string& name, const std::vector<std::string>& value) {
-      m_impl->set_class(name, value);
+      writable_impl()->set_class(name, value);
       action_on_object_update(get_configuration(), name);
     }
 
@@ -528,7 +594,7 @@ class ConfigObject {
       */
 
     void set_date(const std::string& name, const std::vector<std::string>& value) {
-      m_impl->set_date(name, value);
+      writable_impl()->set_date(name, value);
       action_on_object_update(get_configuration(), name);
     }
 
@@ -545,7 +611,7 @@ class ConfigObject {
       */
 
     void set_time(const std::string& name, const std::vector<std::string>& value) {
-      m_impl->set_time(name, value);
+      writable_impl()->set_time(name, value);
       action_on_object_update(get_configuration(), name);
     }
 
@@ -561,7 +627,7 @@ class ConfigObject {
      */
 
     void move(const std::string& at) {
-      m_impl->move(at);
+      writable_impl()->move(at);
     }
 
 
@@ -621,6 +687,11 @@ class ConfigObject {
 
   private:
 
+      // count handles on implementation object: an implementation object without handles can be evicted from cache
+
+    static void add_ref(ConfigObjectImpl * impl) noexcept;
+    static void release_ref(ConfigObjectImpl * impl) noexcept;
+
     ConfigObjectImpl * m_impl;
 
 };
@@ -8,12 +8,14 @@
 #ifndef CONFFWK_CONFIGOBJECTIMPL_H_
 #define CONFFWK_CONFIGOBJECTIMPL_H_
 
+#include <atomic>
 #include <string>
 #include <vector>
 #include <iostream>
 #include <stdint.h>
 
 #include "conffwk/Errors.hpp"
+#include "conffwk/Schema.hpp"
 
 namespace dunedaq {
 namespace conffwk {
@@ -22,6 +24,7 @@ class ConfigObject;
 class Configuration;
 class ConfigurationImpl;
 class DalObject;
+class pool;
 
   /** Possible states of configuration objects. */
   enum ObjectState
@@ -43,6 +46,13 @@ class DalObject;
    *
    *  The methods may throw dunedaq::conffwk::Generic exception in case of an error
    *  unless \b noexcept is explicitly used in their specification.
+   *
+   *  \note Incompatible change for implementations: the protected \b std::string \b m_id member is
+   *  replaced by the \b m_id_ptr pointer to the ID interned by the configuration implementation, which
+   *  keys the caches. A derived class reads the ID via UID(). It may not modify the ID: a renamed object
+   *  gets new interned ID from Configuration::rename_object(). A \b const \b std::string& member cannot
+   *  replace \b m_id: it would keep the old ID after a rename and dangle after the object is detached
+   *  from cleared implementation.
    */
 
 class ConfigObjectImpl {
@@ -55,7 +65,7 @@ class ConfigObjectImpl {
 
   public:
 
-      /// The constructor stores configuration implementation pointer
+      /// The constructor stores configuration implementation pointer and interns the object ID
     ConfigObjectImpl(ConfigurationImpl * impl, const std::string& id, dunedaq::conffwk::ObjectState state = dunedaq::conffwk::Valid) noexcept;
 
       /// The virtual destructor
@@ -80,7 +90,7 @@ class ConfigObjectImpl {
     UID() const noexcept
     {
       std::lock_guard<std::mutex> scoped_lock(m_mutex); // be sure no one renames the object
-      return m_id;
+      return *m_id_ptr;
     }
 
       /// Virtual method to get object's class name
@@ -90,6 +100,13 @@ class ConfigObjectImpl {
       return *m_class_name;
     }
 
+      /// Dense identifier of object's class assigned by Configuration::get_class_id(), when the object is put into cache (Configuration::unknown_class_id before)
+    std::size_t
+    class_id() const noexcept
+    {
+      return m_class_id;
+    }
+
       /// Virtual method to get object's database file name
     virtual const std::string contained_in() const = 0;
 
@@ -177,6 +194,110 @@ class ConfigObjectImpl {
     virtual void get(const std::string& association, std::vector<ConfigObject>& value) = 0;
 
 
+  public:
+
+      /**
+       *  The methods below read values of attributes and relationships using pre-resolved handles (see AttributeHandle and RelationshipHandle).
+       *  By default they read value by name; a plugin may override them to avoid lookup of attribute or relationship by name.
+       *  A plugin class declaring the methods reading values by name should bring these ones in scope by "using ConfigObjectImpl::get;".
+       */
+
+      /// Virtual method to read boolean attribute value using handle
+    virtual void get(const AttributeHandle& attribute, bool& value) { get(attribute.name(), value); }
+
+      /// Virtual method to read unsigned char attribute value using handle
+    virtual void get(const AttributeHandle& attribute, uint8_t& value) { get(attribute.name(), value); }
+
+      /// Virtual method to read signed char attribute value using handle
+    virtual void get(const AttributeHandle& attribute, int8_t& value) { get(attribute.name(), value); }
+
+      /// Virtual method to read unsigned short attribute value using handle
+    virtual void get(const AttributeHandle& attribute, uint16_t& value) { get(attribute.name(), value); }
+
+      /// Virtual method to read signed short attribute value using handle
+    virtual void get(const AttributeHandle& attribute, int16_t& value) { get(attribute.name(), value); }
+
+      /// Virtual method to read unsigned long attribute value using handle
+    virtual void get(const AttributeHandle& attribute, uint32_t& value) { get(attribute.name(), value); }
+
+      /// Virtual method to read signed long attribute value using handle
+    virtual void get(const AttributeHandle& attribute, int32_t& value) { get(attribute.name(), value); }
+
+      /// Virtual method to read unsigned 64 bits integer attribute value using handle
+    virtual void get(const AttributeHandle& attribute, uint64_t& value) { get(attribute.name(), value); }
+
+      /// Virtual method to read signed 64 bits integer attribute value using handle
+    virtual void get(const AttributeHandle& attribute, int64_t& value) { get(attribute.name(), value); }
+
+      /// Virtual method to read float attribute value using handle
+    virtual void get(const AttributeHandle& attribute, float& value) { get(attribute.name(), value); }
+
+      /// Virtual method to read double attribute value using handle
+    virtual void get(const AttributeHandle& attribute, double& value) { get(attribute.name(), value); }
+
+      /// Virtual method to read string attribute value using handle
+    virtual void get(const AttributeHandle& attribute, std::string& value) { get(attribute.name(), value); }
+
+      /// Virtual method to read relationship single-value using handle
+    virtual void get(const RelationshipHandle& association, ConfigObject& value) { get(association.name(), value); }
+
+      /// Virtual method to read vector-of-booleans attribute value using handle
+    virtual void get(const AttributeHandle& attribute, std::vector<bool>& value) { get(attribute.name(), value); }
+
+      /// Virtual method to read vector-of-unsigned-chars attribute value using handle
+    virtual void get(const AttributeHandle& attribute, std::vector<uint8_t>& value) { get(attribute.name(), value); }
+
+      /// Virtual method to read vector-of-signed-chars attribute value using handle
+    virtual void get(const AttributeHandle& attribute, std::vector<int8_t>& value) { get(attribute.name(), value); }
+
+      /// Virtual method to read vector-of-unsigned-shorts attribute value using handle
+    virtual void get(const AttributeHandle& attribute, std::vector<uint16_t>& value) { get(attribute.name(), value); }
+
+      /// Virtual method to read vector-of-signed-shorts attribute value using handle
+    virtual void get(const AttributeHandle& attribute, std::vector<int16_t>& value) { get(attribute.name(), value); }
+
+      /// Virtual method to read vector-of-unsigned-longs attribute value using handle
+    virtual void get(const AttributeHandle& attribute, std::vector<uint32_t>& value) { get(attribute.name(), value); }
+
+      /// Virtual method to read vector-of-signed-longs attribute value using handle
+    virtual void get(const AttributeHandle& attribute, std::vector<int32_t>& value) { get(attribute.name(), value); }
+
+      /// Virtual method to read vector-of-unsigned-64-bits-integers attribute value using handle
+    virtual void get(const AttributeHandle& attribute, std::vector<uint64_t>& value) { get(attribute.name(), value); }
+
+      /// Virtual method to read vector-of-signed-64-bits-integers attribute value using handle
+    virtual void get(const AttributeHandle& attribute, std::vector<int64_t>& value) { get(attribute.name(), value); }
+
+      /// Virtual method to read vector-of-floats attribute value using handle
+    virtual void get(const AttributeHandle& attribute, std::vector<float>& value) { get(attribute.name(), value); }
+
+      /// Virtual method to read vector-of-doubles attribute value using handle
+    virtual void get(const AttributeHandle& attribute, std::vector<double>& value) { get(attribute.name(), value); }
+
+      /// Virtual method to read vector-of-strings attribute value using handle
+    virtual void get(const AttributeHandle& attribute, std::vector<std::string>& value) { get(attribute.name(), value); }
+
+      /// Virtual method to read vector-of-conffwk-objects relationship value using handle
+    virtual void get(const RelationshipHandle& association, std::vector<ConfigObject>& value) { get(association.name(), value); }
+
+
+  public:
+
+      /**
+       *  \brief Virtual method to read values of all attributes.
+       *
+       *  The values are stored in order of attributes of the class description (including inherited attributes).
+       *  By default the attributes are read one by one by name; a plugin may override the method to read them in one pass.
+       *
+       *  \param description  description of object's class returned by Configuration::get_class_info()
+       *  \param values       returned values of attributes
+       */
+    virtual void get_batch(const class_t& description, std::vector<attribute_value_t>& values);
+
+      /// Read value of attribute by name according to type of attribute
+    void get_value(const attribute_t& attribute, attribute_value_t& value);
+
+
   public:
 
       /// Virtual method to read any relationship value without throwing an exception if there is no such relationship (return false)
@@ -309,6 +430,8 @@ class ConfigObjectImpl {
     bool
     is_deleted() const
     {
+      check_generation();
+
       if (m_state == dunedaq::conffwk::Unknown)
         {
           const_cast<ConfigObjectImpl *>(this)->reset();
@@ -321,10 +444,17 @@ class ConfigObjectImpl {
   protected:
 
     ConfigurationImpl * m_impl;               /*!< Pointer to configuration implementation object */
-    dunedaq::conffwk::ObjectState m_state;         /*!< State of the object */
-    std::string m_id;                         /*!< Object ID */
+    std::atomic<dunedaq::conffwk::ObjectState> m_state; /*!< State of the object; it is read without locks by the cache hit path */
+    const std::string * m_id_ptr;             /*!< Object ID interned by the configuration implementation (use UID() to get it) */
     const std::string * m_class_name;         /*!< Name of object's class */
+    std::size_t m_class_id;                   /*!< Dense identifier of object's class */
     mutable std::mutex m_mutex;               /*!< Mutex protecting concurrent access to this object */
+    std::atomic<unsigned long> m_generation;  /*!< Generation of implementation objects the object was last unread at */
+    const std::atomic<unsigned long> * m_impl_generation; /*!< Current generation of implementation objects */
+    std::atomic<unsigned long> m_refs;        /*!< Number of ConfigObject handles on the object; the object without handles can be evicted from cache */
+    std::atomic<unsigned long> m_last_used;   /*!< Time of last access to the object in cache, if the cache size is limited */
+    std::atomic<bool> m_accessed;             /*!< The object was read or found in cache by user request, i.e. not by prefetch (see Configuration::save_access_trace()) */
+    conffwk::pool * m_pool;                   /*!< Memory pool the object is allocated in or nullptr */
 
 
   protected:
@@ -338,13 +468,40 @@ class ConfigObjectImpl {
     {
       if (is_deleted())
         {
-          throw dunedaq::conffwk::DeletedObject(ERS_HERE, m_class_name->c_str(), m_id.c_str());
+          throw dunedaq::conffwk::DeletedObject(ERS_HERE, m_class_name->c_str(), m_id_ptr->c_str());
+        }
+    }
+
+    /**
+     * Apply pending unread of implementation objects (see Configuration::unread_implementation_objects()),
+     * if the object's generation is outdated: clear the object and set its state
+     */
+    void
+    check_generation() const noexcept
+    {
+      if (m_generation.load(std::memory_order_relaxed) != m_impl_generation->load(std::memory_order_acquire))
+        {
+          const_cast<ConfigObjectImpl *>(this)->unread();
         }
     }
 
 
   private:
 
+    void unread() noexcept;
+
+      // detach object referenced by ConfigObject handles from destroyed implementation; it is destroyed when the last handle is released
+      // return false, if there are no handles anymore (then the caller destroys the object)
+
+    bool orphan() noexcept;
+
+      // the bit of references counter marking orphan, so the handle releasing the last reference does not need to read the object
+
+    static constexpr unsigned long s_orphan = 1UL << (sizeof(unsigned long) * 8 - 1);
+
+    static void destroy_orphan(ConfigObjectImpl * obj) noexcept;
+
+
       // convert attribute values, if there is a configuration converter
 
     void convert(bool& value,            const ConfigObject& obj, const std::string& attr_name) noexcept;
@@ -11,14 +11,21 @@
 
 #include <string.h>
 
+#include <array>
 #include <atomic>
 #include <typeinfo>
+#include <type_traits>
 #include <string>
+#include <string_view>
 #include <vector>
 #include <list>
+#include <memory>
+#include <map>
+#include <unordered_map>
 #include <set>
 
 #include <mutex>
+#include <shared_mutex>
 
 #include <boost/property_tree/ptree.hpp>
 
@@ -28,9 +35,12 @@
 #include "conffwk/ConfigObject.hpp"
 #include "conffwk/ConfigVersion.hpp"
 #include "conffwk/Errors.hpp"
+#include "conffwk/Schema.hpp"
 #include "conffwk/DalFactory.hpp"
 
+#include "conffwk/flat_map.hpp"
 #include "conffwk/map.hpp"
+#include "conffwk/pool.hpp"
 #include "conffwk/set.hpp"
 
 namespace dunedaq {
@@ -39,12 +49,56 @@ class DalObject;
 class ConfigAction;
 class ConfigurationImpl;
 class ConfigurationChange;
+class ConfigurationSnapshot;
 
 
 struct class_t;
 
 class Configuration;
 
+
+/**
+ * \brief Approximate memory used by cached objects of a class.
+ *
+ *  The sizes include the objects and their cache index entries, but not
+ *  memory allocated by the objects themselves (e.g. for read strings and vectors).
+ *  See Configuration::memory_usage().
+ */
+
+struct memory_usage_t
+{
+  std::size_t p_impl_objects = 0;       ///< number of implementation objects (ConfigObjectImpl)
+  std::size_t p_impl_bytes = 0;         ///< size of implementation objects
+  std::size_t p_dal_objects = 0;        ///< number of template objects (excluding generated ones)
+  std::size_t p_dal_bytes = 0;          ///< size of template objects
+  std::size_t p_generated_objects = 0;  ///< number of generated template objects (having ID different from the conffwk object ID)
+  std::size_t p_generated_bytes = 0;    ///< size of generated template objects
+  std::size_t p_tangled_objects = 0;    ///< number of implementation objects deleted and replaced by others as result of rename
+  std::size_t p_tangled_bytes = 0;      ///< size of tangled implementation objects
+
+  std::size_t
+  total_bytes() const noexcept
+  {
+    return (p_impl_bytes + p_dal_bytes + p_generated_bytes + p_tangled_bytes);
+  }
+};
+
+
+/**
+ * \brief Statistics of warm-up of template objects of a class.
+ *
+ *  The times are in seconds. See Configuration::warmup().
+ */
+
+struct warmup_info_t
+{
+  std::size_t p_objects = 0;  ///< number of created template objects
+  double p_read_time = 0;     ///< time to read implementation objects
+  double p_create_time = 0;   ///< time to create template objects
+  double p_init_time = 0;     ///< time to initialize template objects summed over all threads
+};
+
+
 /**
  * \brief Defines base class for cache of template objects.
  *
@@ -62,7 +116,7 @@ class CacheBase
 protected:
 
   CacheBase(const DalFactoryFunctions& f) :
-      m_functions(f)
+      m_functions(f), m_generation(0)
   {
     ;
   }
@@ -82,6 +136,10 @@ protected:
 
   const DalFactoryFunctions& m_functions;
 
+    // generation of template objects of this class; incremented to unread all of them
+
+  std::atomic<unsigned long> m_generation;
+
 };
 
 
@@ -171,7 +229,7 @@ catch (dunedaq::conffwk::Exception & ex) {
    *
    *  For objects of classes generated by genconffwk there are analogous template methods which
    *  in addition store pointers to objects in the cache and which to be used by end-user:
-   *  - get(const std::string& id, bool, bool, unsigned long, const std::vector<std::string> *) return const pointer to object of given user class
+   *  - get(std::string_view id, bool, bool, unsigned long, const std::vector<std::string> *) return const pointer to object of given user class
    *  - get(std::vector<const T*>& objects, bool, bool, const std::string& query, unsigned long, const std::vector<std::string> *) fills vector of objects of given user class
    *
    *  Below there is an example for generated \b dal package:
@@ -217,6 +275,7 @@ class Configuration {
   friend class ConfigObject;
   friend class ConfigurationImpl;
   friend class CacheBase;
+  friend class DalFactory;
 
   public:
 
@@ -230,6 +289,13 @@ class Configuration {
        *  The plugin-parameter is optional; if non-empty, it is passed to the plug-in
        *  constructor.
        *
+       *  If the TDAQ_DB_SNAPSHOT_CACHE environment variable points to a directory and the
+       *  plugin-parameter is a database file name, the database is read from the binary
+       *  snapshot of the database stored in that directory instead of the plug-in
+       *  (see SnapshotCacheImpl). The snapshot is written, when the database is loaded by
+       *  the plug-in, and rebuilt, when any database file is modified. The snapshot does not
+       *  support modification, subscription and queries; to use them, call leave_snapshot_cache().
+       *
        *  \param spec         database name to be understood by the database implementation
        *
        *  \throw dunedaq::conffwk::Generic in case of an error
@@ -420,6 +486,13 @@ class Configuration {
        *
        *  It is used by the database implementation.
        *  Update cache of template DB objects.
+       *
+       *  The caller locks the template objects mutex in shared mode and the update mutex in exclusive mode.
+       *  The update does not insert or remove cached objects, so the cache hits of get(), find() and is_valid()
+       *  by other threads are not stalled by the change set. The shared owners of the template objects mutex
+       *  reading implementation objects (ref(), cast() and DalObject::check_init()) lock the update mutex in
+       *  shared mode and wait, since they may revive objects removed by the update (see ConfigurationImpl::insert_object()).
+       *  At the end the tangled objects replaced by rename and not referenced anymore are reclaimed.
        */
 
     void update_cache(std::vector<ConfigurationChange *>& changes) noexcept;
@@ -460,8 +533,8 @@ class Configuration {
        *  Is used by automatically generated data access libraries code after reading parameters for substitution,
        *  since cache contains objects with non-substituted attributes. Should not be explicitly used by user.
        *
-       *  The method is used by the unread_all_objects() method.
-       *  \param  cache_ptr pointer to the cache of template object of given template class (has to be downcasted)
+       *  The method only increments generation of objects of the class, they are re-read when accessed next time.
+       *  \param  cache_ptr pointer to the cache of template object of given template class
        */
 
     template<class T> static void _unread_objects(CacheBase * cache_ptr) noexcept;
@@ -475,13 +548,40 @@ class Configuration {
        *
        *  The method is used by the unread_all_objects() method.
        *  \param  cache_ptr pointer to the cache of template object of given template class (has to be downcasted)
-       *  \param  old_id old object ID
-       *  \param  new_id new object ID
+       *  \param  old_id old object ID (interned by the configuration implementation)
+       *  \param  new_id new object ID (interned by the configuration implementation)
        */
 
     template<class T> static void _rename_object(CacheBase* cache_ptr, const std::string& old_id, const std::string& new_id) noexcept;
 
 
+      /**
+       *  \brief Add number and size of cached template objects of given template class.
+       *
+       *  Is used by automatically generated data access libraries. Should not be explicitly used by user.
+       *
+       *  The method is used by the memory_usage() method.
+       *  \param  cache_ptr pointer to the cache of template object of given template class (has to be downcasted)
+       *  \param  usage     memory usage of the class to be updated
+       */
+
+    template<class T> static void _memory_usage(const CacheBase* cache_ptr, memory_usage_t& usage) noexcept;
+
+
+      /**
+       *  \brief Replace implementation objects of cached template objects of given template class.
+       *
+       *  Is used by automatically generated data access libraries. Should not be explicitly used by user.
+       *
+       *  The method is used by the leave_snapshot_cache() method to bind template objects read from snapshot
+       *  to the objects of implementation plug-in; the caller has to lock template and implementation objects mutexes.
+       *  \param  db        the configuration
+       *  \param  cache_ptr pointer to the cache of template object of given template class (has to be downcasted)
+       */
+
+    template<class T> static void _rebind_objects(Configuration& db, CacheBase* cache_ptr) noexcept;
+
+
       /**
        *  \brief Update state of all objects in cache after abort / commit operations.
        *
@@ -517,7 +617,7 @@ class Configuration {
     void
     unread_template_objects() noexcept
     {
-      std::lock_guard<std::mutex> scoped_lock(m_tmpl_mutex);
+      std::lock_guard<std::shared_mutex> scoped_lock(m_tmpl_mutex);
       _unread_template_objects();
     }
 
@@ -541,7 +641,7 @@ class Configuration {
   private:
 
     static void
-    update_impl_objects(conffwk::pmap<conffwk::map<ConfigObjectImpl *> * >& cache, ConfigurationChange& change, const std::string * class_name);
+    update_impl_objects(conffwk::fmap<conffwk::fmap<ConfigObjectImpl *> * >& cache, const ConfigurationImpl& impl, ConfigurationChange& change, const std::string * class_name);
 
     void
     _unread_template_objects() noexcept;
@@ -669,6 +769,9 @@ class Configuration {
        *  \brief Get object by class name and object id (multi-thread safe).
        *
        *  The method searches an object with given id within the class and all derived subclasses.
+       *  If the object is in the implementation objects cache and is up to date, it is returned without
+       *  locking of the implementation (only the cache shard of the class is locked), so the threads
+       *  getting cached objects do not block each other.
        *
        *  \param class_name   name of the class
        *  \param id           object identity
@@ -699,6 +802,30 @@ class Configuration {
     void get(const std::string& class_name, std::vector<ConfigObject>& objects, const std::string& query = "", unsigned long rlevel = 0, const std::vector<std::string> * rclasses = 0);
 
 
+      /**
+       *  \brief Get values of attribute of all objects of class.
+       *
+       *  The method reads value of given attribute of all objects of given class and of its subclasses
+       *  into contiguous vector, so it can be scanned by simple loops. The attribute is resolved once
+       *  (see get_attribute_handle()), the values are read by single call of implementation
+       *  (see ConfigurationImpl::get_column(); unless the plug-in overrides it, the values are read object by object)
+       *  and converted as for ConfigObject::get().
+       *
+       *  Template parameter T is the same as for ConfigObject::get() to read the attribute.
+       *
+       *  \param class_name   name of the class
+       *  \param attribute    name of the attribute
+       *  \param values       returned values of attribute
+       *  \param objs         if not null, returns objects in order of values
+       *
+       *  \throw dunedaq::conffwk::NotFound exception if there is no such class or attribute, or \b dunedaq::conffwk::Generic in case of an error
+       */
+
+    template<class T>
+      void
+      get_column(const std::string& class_name, const std::string& attribute, std::vector<T>& values, std::vector<ConfigObject> * objs = nullptr);
+
+
       /**
        *  \brief Get path between objects.
        *
@@ -721,6 +848,8 @@ class Configuration {
        *  \brief Get object of given class by identity and instantiate the template parameter with it (multi-thread safe).
        *
        *  Such method to be used for user classes generated by the genconffwk utility.
+       *  If the object is already in the cache, the method only takes shared lock on template objects,
+       *  so concurrent readers do not serialize; a new object is created under exclusive lock.
        *
        *  \param id             object identity
        *  \param init_children  if true, the referenced objects are initialized
@@ -735,10 +864,18 @@ class Configuration {
 
   template<class T>
     const T *
-    get(const std::string& id, bool init_children = false, bool init = true, unsigned long rlevel = 0, const std::vector<std::string> * rclasses = 0)
+    get(std::string_view id, bool init_children = false, bool init = true, unsigned long rlevel = 0, const std::vector<std::string> * rclasses = 0)
     {
-      std::lock_guard<std::mutex> scoped_lock(m_tmpl_mutex);
-      return _get<T>(id, init_children, init, rlevel, rclasses);
+      {
+        std::shared_lock<std::shared_mutex> scoped_lock(m_tmpl_mutex);
+        if (const T * obj = _find_cached<T>(id))
+          return obj;
+      }
+
+      std::lock_guard<std::shared_mutex> scoped_lock(m_tmpl_mutex);
+      const T * obj = _get<T>(id, init_children, init, rlevel, rclasses);
+      _check_cache_limit();
+      return obj;
     }
 
 
@@ -761,7 +898,13 @@ class Configuration {
     const T *
     get(ConfigObject& obj, bool init_children = false, bool init = true)
     {
-      std::lock_guard<std::mutex> scoped_lock(m_tmpl_mutex);
+      {
+        std::shared_lock<std::shared_mutex> scoped_lock(m_tmpl_mutex);
+        if (const T * x = _find_cached<T>(obj, obj.m_impl->m_id_ptr))
+          return x;
+      }
+
+      std::lock_guard<std::shared_mutex> scoped_lock(m_tmpl_mutex);
       return _get<T>(obj, init_children, init);
     }
 
@@ -786,8 +929,12 @@ class Configuration {
     void
     get(std::vector<const T*>& objects, bool init_children = false, bool init = true, const std::string& query = "", unsigned long rlevel = 0, const std::vector<std::string> * rclasses = 0)
     {
-      std::lock_guard<std::mutex> scoped_lock(m_tmpl_mutex);
+      if (!query.empty())
+        check_snapshot_cache("queried");
+
+      std::lock_guard<std::shared_mutex> scoped_lock(m_tmpl_mutex);
       _get<T>(objects, init_children, init, query, rlevel, rclasses);
+      _check_cache_limit();
     }
 
   /**
@@ -807,7 +954,7 @@ class Configuration {
     const T *
     get(ConfigObject& obj, const std::string& id)
     {
-      std::lock_guard<std::mutex> scoped_lock(m_tmpl_mutex);
+      std::lock_guard<std::shared_mutex> scoped_lock(m_tmpl_mutex);
       return _get<T>(obj, id);
     }
 
@@ -826,9 +973,9 @@ class Configuration {
 
   template<class T>
     const T *
-    find(const std::string& id)
+    find(std::string_view id)
     {
-      std::lock_guard<std::mutex> scoped_lock(m_tmpl_mutex);
+      std::shared_lock<std::shared_mutex> scoped_lock(m_tmpl_mutex);
       return _find<T>(id);
     }
 
@@ -850,8 +997,20 @@ class Configuration {
        */
 
     template<class T> const T * ref(ConfigObject& obj, const std::string& name, bool init = false) {
-      std::lock_guard<std::mutex> scoped_lock(m_tmpl_mutex);
-      return _ref<T>(obj, name, init);
+      ConfigObject res;
+
+      {
+        std::shared_lock<std::shared_mutex> scoped_lock(m_tmpl_mutex);
+        std::shared_lock<std::shared_mutex> scoped_lock2(m_update_mutex);  // the relationship is read via plug-in
+        _read_ref(obj, name, T::s_class_name, res);
+        if (res.is_null())
+          return nullptr;
+        if (const T * x = _find_cached<T>(res, res.m_impl->m_id_ptr))
+          return x;
+      }
+
+      std::lock_guard<std::shared_mutex> scoped_lock(m_tmpl_mutex);
+      return get_cache<T>()->get(*this, res, init, init);
     }
 
 
@@ -870,7 +1029,7 @@ class Configuration {
        */
 
     template<class T> void ref(ConfigObject& obj, const std::string& name, std::vector<const T*>& objects, bool init = false) {
-      std::lock_guard<std::mutex> scoped_lock(m_tmpl_mutex);
+      std::lock_guard<std::shared_mutex> scoped_lock(m_tmpl_mutex);
       _ref<T>(obj, name, objects, init);
     }
 
@@ -882,7 +1041,7 @@ class Configuration {
        *  The method returns objects of class V, which have references on given object via explicitly provided relationship name.
        *  If the relationship name is set to "*", then the method takes into account  all relationships of all objects.
        *  The method is efficient only for composite relationships (i.e. when a parent has composite reference on this object).
-       *  For generic relationships the method performs full scan of all database objects.
+       *  For generic relationships the method performs full scan of all database objects, unless the index of references is enabled (see set_references_index()).
        *  It is not recommended at large scale to build complete graph of relations between all database object.
        *
        *  \param obj                   object
@@ -910,7 +1069,7 @@ class Configuration {
      *  Note, this will be a random base class, not the closest based one.
      *
      *  The method is efficient only for composite relationships (i.e. when a parent has composite reference on this object).
-     *  For generic relationships the method performs full scan of all database objects.
+     *  For generic relationships the method performs full scan of all database objects, unless the index of references is enabled (see set_references_index()).
      *  It is not recommended at large scale to build complete graph of relations between all database object.
      *
      *  \param obj                   object
@@ -943,11 +1102,15 @@ class Configuration {
 
   private:
 
+    /// Get object from implementation objects cache or read it locking the m_impl_mutex (the caller must not own it).
     /// \throw dunedaq::conffwk::Generic or dunedaq::conffwk::NotFound
     void _get(const std::string& class_name, const std::string& id, ConfigObject& object, unsigned long rlevel, const std::vector<std::string> * rclasses);
 
+    /// \throw dunedaq::conffwk::Generic or dunedaq::conffwk::NotFound
+    void _get(const std::string& class_name, std::vector<ConfigObject>& objects, const std::string& query, unsigned long rlevel, const std::vector<std::string> * rclasses);
+
     /// \throw dunedaq::conffwk::Generic
-    template<class T> const T * _get(const std::string& id, bool init_children = false, bool init = true, unsigned long rlevel = 0, const std::vector<std::string> * rclasses = 0);
+    template<class T> const T * _get(std::string_view id, bool init_children = false, bool init = true, unsigned long rlevel = 0, const std::vector<std::string> * rclasses = 0);
 
     /// \throw dunedaq::conffwk::Generic
     template<class T> const T * _get(ConfigObject& obj, bool init_children = false, bool init = true);
@@ -958,6 +1121,13 @@ class Configuration {
     /// \throw dunedaq::conffwk::Generic
     template<class T> void _get(std::vector<const T*>& objects, bool init_children = false, bool init = true, const std::string& query = "", unsigned long rlevel = 0, const std::vector<std::string> * rclasses = 0);
 
+    /// Get object from template objects cache without insertion of new objects; to be used by shared owner of the m_tmpl_mutex.
+    /// Return nullptr, if there is no such object in cache yet.
+    template<class T> const T * _find_cached(std::string_view id) noexcept;
+
+    /// Get object with given interned ID from template objects cache, if the conffwk object is its implementation (see Cache<T>::find()).
+    template<class T> const T * _find_cached(ConfigObject& obj, const std::string * id) noexcept;
+
     /// \throw dunedaq::conffwk::Generic
     template<class T> DalObject * _make_instance(ConfigObject& obj, const std::string& uid)
     {
@@ -993,11 +1163,11 @@ class Configuration {
 
 
       /**
-       *  \brief Multi-thread unsafe version of find(const std::string&) method
+       *  \brief Multi-thread unsafe version of find(std::string_view) method
        *  \throw dunedaq::conffwk::Generic in case of an error
        */
 
-    template<class T> const T * _find(const std::string& id);
+    template<class T> const T * _find(std::string_view id);
 
 
       /**
@@ -1018,6 +1188,37 @@ class Configuration {
     template<class T> void _ref(ConfigObject& obj, const std::string& name, std::vector<const T*>& results, bool read_children);
 
 
+  private:
+
+      /// Get template object referenced by initialized object; see _ref() methods.
+      /// When called from DalObject::check_init() by shared owner of the m_tmpl_mutex, only cached objects are returned;
+      /// otherwise the exclusive_lock_required is thrown and the initialization is repeated by exclusive owner.
+
+    template<class T> const T * _get_ref(ConfigObject& obj, bool read_children);
+
+      /// Thrown to DalObject::check_init(), when the initialization of template object needs to insert new objects into cache
+
+    struct exclusive_lock_required {};
+
+      /// Set for the thread initializing template objects by shared owner of the m_tmpl_mutex
+
+    class shared_init_guard
+    {
+    public:
+      explicit shared_init_guard(const Configuration& db) noexcept : m_prev(s_shared_init) { s_shared_init = &db; }
+      ~shared_init_guard() noexcept { s_shared_init = m_prev; }
+      shared_init_guard(const shared_init_guard&) = delete;
+      shared_init_guard& operator=(const shared_init_guard&) = delete;
+    private:
+      const Configuration * m_prev;
+    };
+
+    static inline thread_local const Configuration * s_shared_init = nullptr;
+
+
+  public:
+
+
       /**
        * \brief Checks if cast from source class to target class is allowed.
        *
@@ -1032,6 +1233,58 @@ class Configuration {
     bool try_cast(const std::string* target, const std::string* source) noexcept;
 
 
+      /**
+       * \brief Get dense class identifier.
+       *
+       * The identifiers are assigned to all classes of the loaded schema in range [0, number of classes).
+       * They are reassigned, when the schema is changed (e.g. on load() or unload()).
+       * The identifier of object's class is also available via ConfigObjectImpl::class_id().
+       *
+       * \param class_name  name of class interned by the DalFactory
+       *
+       * \return Return identifier or unknown_class_id, if there is no such class in schema
+       */
+
+    std::size_t get_class_id(const std::string * class_name) const noexcept
+      {
+        auto i = m_class_ids.find(class_name);
+        return (i != m_class_ids.end() ? i->second : unknown_class_id);
+      }
+
+
+      /**
+       * \brief Checks if the source class is the target class or its subclass.
+       *
+       * Both classes are given by identifiers returned by get_class_id(). The check is single bit test.
+       *
+       * \return Return \b true if the cast is allowed by database schema
+       */
+
+    bool is_a(std::size_t source, std::size_t target) const noexcept
+      {
+        if (source >= m_class_names.size() || target >= m_class_names.size())
+          return false;
+
+        return (m_superclasses_bits[source * m_superclasses_bits_row + target / 64] >> (target % 64)) & 1;
+      }
+
+
+      /// Identifier of class, which is not in schema
+
+    static constexpr std::size_t unknown_class_id = static_cast<std::size_t>(-1);
+
+
+  private:
+
+      /// same as try_cast(const std::string*, const std::string*) for object, using identifier of its class
+
+    bool try_cast(const std::string* target, const ConfigObjectImpl * obj) const noexcept
+      {
+        const std::size_t source = obj->class_id();
+        return (target == obj->m_class_name || is_a(source != unknown_class_id ? source : get_class_id(obj->m_class_name), get_class_id(target)));
+      }
+
+
   private:
 
       /** Helper method to prepare exception text when template ref() method fails **/
@@ -1039,6 +1292,11 @@ class Configuration {
     static std::string mk_ref_ex_text(const char * what, const std::string& cname, const std::string& rname, const ConfigObject& obj) noexcept;
 
 
+      /** Helper method to read single value of relationship used by template ref() methods; throws exception prepared by mk_ref_ex_text() **/
+
+    static void _read_ref(ConfigObject& obj, const std::string& name, const std::string& cname, ConfigObject& res);
+
+
       /** Helper method to prepare exception text when template referenced_by() method fails **/
 
     static std::string mk_ref_by_ex_text(const std::string& cname, const std::string& rname, const ConfigObject& obj) noexcept;
@@ -1064,12 +1322,32 @@ class Configuration {
        *  If name is empty, take it from TDAQ_DB_NAME and TDAQ_DB_DATA
        *  environment variables.
        *
+       *  The TDAQ_DB_SNAPSHOT_CACHE environment variable is used as by the constructor.
+       *
        *  \throw dunedaq::conffwk::Generic in case of an error
        */
 
     void load(const std::string& db_name);
 
 
+      /**
+       *  \brief Replace database snapshot by implementation plug-in.
+       *
+       *  If the database was read from snapshot (see TDAQ_DB_SNAPSHOT_CACHE), it is opened by the plug-in
+       *  and the template objects are bound to the objects of the plug-in. The snapshot is kept until unload()
+       *  for ConfigObject handles on its objects; they are replaced by the objects of the plug-in, when used for
+       *  modification or query. Does nothing, if the database was not read from snapshot.
+       *
+       *  The snapshot does not support modification, subscription and queries; they throw an exception until
+       *  the method is called. As load(), the method replaces the implementation and is not thread-safe:
+       *  it has to be called before the configuration object is used by other threads.
+       *
+       *  \throw dunedaq::conffwk::Generic in case of an error
+       */
+
+    void leave_snapshot_cache();
+
+
       /**
        *  \brief Unload database.
        *
@@ -1218,6 +1496,120 @@ class Configuration {
     void prefetch_all_data();
 
 
+    /**
+     *  \brief Fill cache of template objects of given classes.
+     *
+     *  The method creates template objects of given classes and of classes of objects they reference
+     *  (recursively), so the initialization of template objects does not need to create new ones.
+     *  The implementation objects are read and the template objects are created class by class,
+     *  then the template objects are initialized in parallel by given number of threads.
+     *  The classes of referenced objects without registered DAL classes are ignored.
+     *
+     *  \param classes  names of classes with registered DAL classes
+     *  \param threads  number of threads initializing template objects (if 0, use number of hardware threads)
+     *
+     *  \return Return number of objects and timings for each class, for which template objects were created.
+     *
+     *  \throw dunedaq::conffwk::Generic in case of an error
+     */
+
+    std::map<std::string, warmup_info_t> warmup(const std::vector<std::string>& classes, unsigned int threads = 0);
+
+
+    /**
+     *  \brief Save access trace.
+     *
+     *  The method writes to the file the class names and IDs of objects accessed by the process, one object per line
+     *  (class name and object ID are separated by tab). An object is accessed, when it is read or found in the cache
+     *  by user request, including the objects evicted from the cache since; the objects read by prefetch (e.g. of
+     *  the access trace itself), by prefetch_all_data() or by writing the snapshot cache are not recorded.
+     *  The existing trace file is replaced, so the trace is the working set of the last run and the objects, which are
+     *  not accessed anymore, are aged out; if no object was accessed, the file is kept.
+     *  The trace is used by prefetch_access_trace() to read the same objects on next start.
+     *
+     *  If the TDAQ_DB_ACCESS_TRACE environment variable is set, the trace is saved to the file it points to
+     *  by the Configuration destructor and it is replayed after the database is loaded (unless TDAQ_DB_PREFETCH_ALL_DATA is set).
+     *
+     *  \param file_name  name of the trace file (it is replaced atomically)
+     *
+     *  \throw dunedaq::conffwk::Generic in case of an error
+     */
+
+    void save_access_trace(const std::string& file_name);
+
+
+    /**
+     *  \brief Prefetch objects of access trace into client cache.
+     *
+     *  The method reads objects listed by the access trace file saved by save_access_trace().
+     *  The objects of classes, which are not defined anymore, and the removed objects are ignored.
+     *  The objects are passed to the implementation by single call of ConfigurationImpl::prefetch(); they are read
+     *  in bulk only, if the plug-in overrides it, otherwise they are read one by one before they are used.
+     *
+     *  \param file_name  name of the trace file
+     *
+     *  \return Return number of objects in the trace.
+     *
+     *  \throw dunedaq::conffwk::Generic in case of an error
+     */
+
+    std::size_t prefetch_access_trace(const std::string& file_name);
+
+
+    /**
+     *  \brief Limit size of implementation objects cache.
+     *
+     *  When the cache exceeds the limit, the least recently used implementation objects,
+     *  which are not referenced by ConfigObject handles (including ones of template objects),
+     *  are removed from cache and will be read again from implementation, when accessed.
+     *  The size is estimated by memory occupied by implementation objects.
+     *
+     *  By default the cache size is not limited, unless TDAQ_DB_CACHE_LIMIT process environment
+     *  variable defines the limit in bytes.
+     *
+     *  \param limit  the limit in bytes (0 means no limit)
+     *
+     *  \throw dunedaq::conffwk::Generic, if there is no implementation loaded
+     */
+
+    void set_cache_limit(std::size_t limit);
+
+
+    /**
+     *  \brief Get limit of implementation objects cache size in bytes (0 means no limit).
+     */
+
+    std::size_t get_cache_limit() const noexcept;
+
+
+    /**
+     *  \brief Get memory used by cached objects.
+     *
+     *  The method returns per class number and approximate size of cached implementation objects,
+     *  template objects, generated template objects and tangled implementation objects.
+     *  Objects of a subclass are only accounted for their own class.
+     *
+     *  \return map of class names to memory usage (empty, if there is no implementation loaded)
+     */
+
+    std::map<std::string, memory_usage_t> memory_usage();
+
+
+    /**
+     *  \brief Make immutable read-only snapshot of configuration.
+     *
+     *  The snapshot contains all objects of database and description of schema.
+     *  It is made while holding the implementation mutex, so it is consistent
+     *  and reflects all changes processed before the call. Queries of snapshot
+     *  do not lock any Configuration mutex and are not affected by later changes
+     *  of database or its unload (see ConfigurationSnapshot).
+     *
+     *  \throw dunedaq::conffwk::Generic, if there is no implementation loaded or in case of a read error
+     */
+
+    std::shared_ptr<const ConfigurationSnapshot> snapshot();
+
+
     // access versions
 
   public:
@@ -1269,12 +1661,220 @@ class Configuration {
     const dunedaq::conffwk::class_t& get_class_info(const std::string& class_name, bool direct_only = false);
 
 
+      /**
+       *  \brief Get pre-resolved handle of attribute of class.
+       *
+       *  The handle is used to read value of attribute of objects of given class or of its subclasses
+       *  avoiding lookup by attribute name (see ConfigObject::get(const AttributeHandle&, T&)).
+       *  The handle is valid until the database is unloaded.
+       *
+       *  \param  class_name   name of the class
+       *  \param  name         name of the attribute
+       *
+       *  \throw dunedaq::conffwk::NotFound exception if there is no such class or attribute, or \b dunedaq::conffwk::Generic in case of a problem
+       */
+
+    dunedaq::conffwk::AttributeHandle get_attribute_handle(const std::string& class_name, const std::string& name);
+
+
+      /**
+       *  \brief Get pre-resolved handle of relationship of class.
+       *
+       *  Same as get_attribute_handle(), but for relationship (see ConfigObject::get(const RelationshipHandle&, T&)).
+       *
+       *  \throw dunedaq::conffwk::NotFound exception if there is no such class or relationship, or \b dunedaq::conffwk::Generic in case of a problem
+       */
+
+    dunedaq::conffwk::RelationshipHandle get_relationship_handle(const std::string& class_name, const std::string& name);
+
+
+    // attribute value indices
+
+  public:
+
+      /**
+       *  \brief Create index of objects of class by value of attribute.
+       *
+       *  The index contains objects of given class and of its subclasses and is used by the find_by() method.
+       *  It is kept up to date, when changes of created, modified and removed objects are notified
+       *  by the implementation (i.e. when there is a subscription, see subscribe()). The local modifications
+       *  of the database (set, create, destroy, rename or abort) are not notified, so after them all indices
+       *  are rebuilt by next find_by(). The index is removed on unload().
+       *  If the index already exists, it is rebuilt.
+       *
+       *  \param class_name   name of the class
+       *  \param attribute    name of single-value attribute
+       *
+       *  \throw dunedaq::conffwk::NotFound exception if there is no such class or attribute, or \b dunedaq::conffwk::Generic in case of an error
+       */
+
+    void create_index(const std::string& class_name, const std::string& attribute);
+
+
+      /**
+       *  \brief Find objects of class having given value of attribute using index.
+       *
+       *  The index has to be created by the create_index() method.
+       *  The type of value has to be the same as for ConfigObject::get() to read the attribute (e.g. uint16_t or std::string).
+       *
+       *  \param class_name   name of the class
+       *  \param attribute    name of the attribute
+       *  \param value        value of the attribute
+       *  \param objects      returned objects
+       *
+       *  \throw dunedaq::conffwk::Generic if there is no such index, the type of value differs from the one of indexed values, or in case of an error
+       */
+
+    void find_by(const std::string& class_name, const std::string& attribute, const attribute_value_t& value, std::vector<ConfigObject>& objects);
+
+
+      /// Find objects of class having given value of attribute using index (see above)
+
+    template<class T>
+      void
+      find_by(const std::string& class_name, const std::string& attribute, const T& value, std::vector<ConfigObject>& objects)
+      {
+        find_by(class_name, attribute, attribute_value_t(std::in_place_type<T>, value), objects);
+      }
+
+
+      /// Find objects of class having given value of string attribute using index (see above)
+
+    void
+    find_by(const std::string& class_name, const std::string& attribute, const char * value, std::vector<ConfigObject>& objects)
+    {
+      find_by(class_name, attribute, attribute_value_t(std::in_place_type<std::string>, value), objects);
+    }
+
+
+  private:
+
+    struct attribute_index_t
+    {
+      attribute_index_t(const AttributeHandle& attribute) : m_attribute(attribute) {}
+
+        /// read and index value of object attribute; remove previous value of object, if any
+
+      void insert(ConfigObject& obj);
+
+        /// remove object from index
+
+      void remove(const std::string& id) noexcept;
+
+      const AttributeHandle m_attribute;
+      std::multimap<attribute_value_t, std::string> m_objects;          // attribute value -> object ID
+      std::unordered_map<std::string, attribute_value_t> m_values;      // object ID -> attribute value
+    };
+
+      // indices of classes by attribute name; the m_index_mutex is locked after the m_impl_mutex
+
+    conffwk::fmap<std::map<std::string, std::unique_ptr<attribute_index_t>>> m_indices;
+
+      // set, if the database was modified locally and the indices have to be rebuilt
+
+    std::atomic<bool> m_indices_outdated;
+
+      // update indices on changes; the caller has to lock the m_impl_mutex
+
+    void update_indices(const std::vector<ConfigurationChange *>& changes) noexcept;
+
+      // mark indices outdated after local modification of the database
+
+    void outdate_indices() noexcept { m_indices_outdated.store(true, std::memory_order_release); }
+
+      // read values of attribute of all objects into index; the caller has to lock the m_impl_mutex
+
+    void fill_index(attribute_index_t& index);
+
+      // rebuild outdated indices (the caller must not own the m_impl_mutex)
+
+    void rebuild_indices();
+
+
+    // index of references
+
+  public:
+
+      /**
+       *  \brief Enable or disable index of references between objects.
+       *
+       *  When enabled, the ConfigObject::referenced_by() method called with check_composite_only = false
+       *  uses the index instead of the implementation, that has to scan all objects for non-composite relationships.
+       *  The index is built on first use and is kept up to date, when changes are notified by the implementation
+       *  (see subscribe()); it is rebuilt after the objects are created, modified, renamed or destroyed by this process.
+       *
+       *  \param enable  if true, enable the index; otherwise disable and destroy it
+       */
+
+    void set_references_index(bool enable) noexcept;
+
+
   private:
 
-      // cache, storing descriptions of schema
+      // object is identified by class name interned by the DalFactory and ID interned by the implementation
+
+    typedef std::pair<const std::string *, const std::string *> object_key_t;
+
+    struct object_key_hash
+    {
+      std::size_t operator()(const object_key_t& x) const noexcept
+      {
+        const std::size_t h = reinterpret_cast<std::size_t>(x.second);
+        return h ^ (reinterpret_cast<std::size_t>(x.first) + 0x9e3779b97f4a7c15ULL + (h << 6) + (h >> 2));
+      }
+    };
+
+    struct reference_t
+    {
+      object_key_t m_object;                 // referencing object
+      const std::string * m_relationship;    // name of relationship interned in references_index_t::m_relationships
+    };
+
+    struct references_index_t
+    {
+        /// index references of object (the caller removes previous ones)
+
+      void insert(ConfigObject& obj, const std::vector<std::string>& relationships);
+
+        /// remove references of object
 
-    conffwk::map<dunedaq::conffwk::class_t *> p_direct_classes_desc_cache;
-    conffwk::map<dunedaq::conffwk::class_t *> p_all_classes_desc_cache;
+      void remove(const object_key_t& key) noexcept;
+
+      conffwk::fmap<std::vector<std::string>> m_relationships;                                        // class -> names of relationships
+      std::unordered_map<object_key_t, std::vector<reference_t>, object_key_hash> m_referenced_by;     // object -> objects referencing it
+      std::unordered_map<object_key_t, std::vector<object_key_t>, object_key_hash> m_references;       // object -> objects referenced by it
+    };
+
+      // the index is accessed under the m_impl_mutex; it is destroyed before the interned IDs are released by unload()
+
+    std::atomic<bool> m_use_references_index;
+    std::unique_ptr<references_index_t> m_references_index;
+
+      // build index; the caller has to lock the m_impl_mutex
+
+    void build_references_index();
+
+      // update index on changes; the caller has to lock the m_impl_mutex
+
+    void update_references_index(const std::vector<ConfigurationChange *>& changes) noexcept;
+
+      // destroy index on changes made by this process, it will be rebuilt on next use; the caller has to lock the m_impl_mutex
+
+    void reset_references_index() noexcept { m_references_index.reset(); }
+
+      // get objects referencing given object using index (the caller must not own the m_impl_mutex)
+
+    void _referenced_by(const ConfigObject& obj, const std::string& relationship_name, std::vector<ConfigObject>& objects, unsigned long rlevel, const std::vector<std::string> * rclasses);
+
+
+  private:
+
+      // cache, storing descriptions of schema (open addressing; lookup by class name does not allocate memory)
+
+    typedef conffwk::flat_map<std::string, dunedaq::conffwk::class_t *, string_view_hash, string_view_equal> classes_desc_cache_t;
+
+    classes_desc_cache_t p_direct_classes_desc_cache;
+    classes_desc_cache_t p_all_classes_desc_cache;
 
   public:
 
@@ -1408,11 +2008,36 @@ class Configuration {
     std::atomic<uint_least64_t> p_number_of_template_object_read;
 
 
+  private:
+
+      // generation of all template objects; the unread_template_objects() increments it and the objects are re-read lazily (see DalObject::check_init())
+
+    std::atomic<unsigned long> m_generation;
+
+
   private:
 
     conffwk::fmap<conffwk::fset> p_superclasses;
     conffwk::fmap<conffwk::fset> p_subclasses;
 
+      // dense identifiers of classes and bit matrix of superclasses: the bit [source * m_superclasses_bits_row * 64 + target] is set, if target is source or its superclass
+
+    conffwk::fmap<std::size_t> m_class_ids;
+    std::vector<const std::string *> m_class_names;
+    std::vector<uint64_t> m_superclasses_bits;
+    std::size_t m_superclasses_bits_row = 0;
+
+      // DAL classes implementing algorithms for objects of given class (index is the class identifier), see DalFactory::class4algo()
+
+    std::vector<std::unordered_map<std::string, const std::string *>> m_class4algo;
+    std::shared_mutex m_class4algo_mutex;  // leaf mutex protecting m_class4algo
+
+      // cached DalFactory::find_class4algo()
+
+    const std::string& class4algo(std::size_t class_id, const std::string& class_name, const std::string& algorithm);
+
+      // rebuild subclasses and identifiers of classes from p_superclasses
+
     void set_subclasses() noexcept;
 
   public:
@@ -1431,7 +2056,21 @@ class Configuration {
   
   private:
 
-    conffwk::map<std::list<AttributeConverterBase*> * > m_convert_map;
+      /**
+       *  The converters registered for each type of attribute value (see register_converter()); all string-based types share the string_type slot.
+       *  A published list is never modified: the register_converter() publishes its updated copy and keeps the replaced list until unload(),
+       *  so the convert() methods read the lists without locking. When there are no converters, they only test the m_has_converters flag.
+       */
+
+    typedef std::vector<AttributeConverterBase*> converters_t;
+
+    std::array<std::atomic<const converters_t *>, class_type + 1> m_converters;
+    std::vector<std::unique_ptr<const converters_t>> m_converters_lists;
+    std::atomic<bool> m_has_converters;
+
+      /// slot of m_converters for type of attribute value
+
+    template<class T> static constexpr std::size_t converter_slot() noexcept;
 
 
     // cache of objects for user-defined classes
@@ -1457,7 +2096,8 @@ class Configuration {
       public:
 
         Cache() :
-            CacheBase(DalFactory::instance().functions(T::s_class_name))
+            CacheBase(DalFactory::instance().functions(T::s_class_name)),
+            m_pool(sizeof(T))
         {
           ;
         }
@@ -1511,7 +2151,7 @@ class Configuration {
             *  \throw dunedaq::conffwk::Generic is no such class for loaded configuration DB schema or in case of an error
             */
 
-          T * get(Configuration& conffwk, const std::string& name, bool init_children, bool init_object, unsigned long rlevel, const std::vector<std::string> * rclasses);
+          T * get(Configuration& conffwk, std::string_view name, bool init_children, bool init_object, unsigned long rlevel, const std::vector<std::string> * rclasses);
 
 
            /**
@@ -1522,7 +2162,7 @@ class Configuration {
             *  In case of success, the new object is put into cache and pointer to the object is returned.
             *  If there is no such object for given template class, then \b null pointer is returned.
             *
-            *  \param id             ID of generated object
+            *  \param id             ID of generated object interned by the configuration implementation
             *
             *  \return Return pointer to object.
             *
@@ -1531,7 +2171,26 @@ class Configuration {
 
 
           T *
-          find(const std::string& id);
+          find(const std::string * id);
+
+
+           /**
+            *  \brief Find template object using ID and bound to given implementation object.
+            *
+            *  The method is a cache hit path of get() methods used by shared owner of the configuration's
+            *  template objects mutex. It never inserts objects and never modifies them: if the template object
+            *  is bound to other implementation object (e.g. the object was re-created), it is a miss and
+            *  the get() method called by exclusive owner of the mutex sets the new implementation object.
+            *
+            *  \param conffwk        the configuration object
+            *  \param obj            the conffwk object expected to be implementation of the template object
+            *  \param id             ID of object interned by the configuration implementation
+            *
+            *  \return Return pointer to object or nullptr, if there is no such object in cache or it has to be re-bound.
+            */
+
+          T *
+          find(Configuration& conffwk, ConfigObject& obj, const std::string * id) noexcept;
 
 
            /**
@@ -1560,8 +2219,13 @@ class Configuration {
 
       private:
 
-        conffwk::map<T*> m_cache;
-        conffwk::multimap<T*> m_t_cache;
+          // create new object in the pool
+
+        T * create(Configuration& conffwk, ConfigObject& obj);
+
+        conffwk::flat_map<const std::string *, T*, string_ptr_hash> m_cache;  // object ID interned by ConfigurationImpl -> object
+        conffwk::fmultimap<T*> m_t_cache;  // ID of conffwk object -> generated objects
+        conffwk::pool m_pool;
 
 
     };
@@ -1576,27 +2240,67 @@ class Configuration {
 
     void rename_object(ConfigObject& obj, const std::string& new_id);
 
+      // Evict implementation objects, if the cache exceeds the limit; the check_cache_limit() is called without locks, the _check_cache_limit() is called by the m_tmpl_mutex owner.
+
+    void check_cache_limit() noexcept;
+
+    void _check_cache_limit() noexcept;
+
+      // Prefetch objects of access trace; the caller has to lock implementation mutex. The replay_access_trace() uses the TDAQ_DB_ACCESS_TRACE file, if it exists.
+
+    void _prefetch(const std::map<std::string, std::vector<std::string>>& objects);
+
+    void replay_access_trace() noexcept;
+
+      // Read database from snapshot file, if TDAQ_DB_SNAPSHOT_CACHE is set and the snapshot is not stale, or write the snapshot after the database is loaded by plug-in.
+      // The use_snapshot_cache() replaces not loaded implementation keeping its cache limit; the caller has to lock implementation mutex.
+      // The save_snapshot_cache() releases the objects it read, unless they were in the cache before or are referenced.
+
+    std::string snapshot_cache_file(const std::string& db_name) const;
+
+    bool use_snapshot_cache(const std::string& db_name);
+
+    void save_snapshot_cache(const std::string& db_name) noexcept;
+
+      // Throw exception on modification, subscription or query of database read from snapshot (see leave_snapshot_cache()).
+      // The implementation is not replaced there, since other threads read it without lock.
+    void check_snapshot_cache(const char * action) const;
+
+      // Replace given handle on object read from snapshot by the one of the plug-in, after leave_snapshot_cache() was called.
+    void leave_snapshot_cache(ConfigObject& obj, const char * action = "modified");
+
+      // Bind template object to the object of current implementation; the caller has to lock template and implementation objects mutexes.
+    void rebind_template_object(DalObject& obj) noexcept;
+
+      // Get object ID interned by implementation; the find_id() returns nullptr, if there is no such ID.
+
+    const std::string& intern_id(std::string_view id);
+
+    const std::string * find_id(std::string_view id) const noexcept;
+
+      // Read values of attribute of objects by the implementation (see ConfigurationImpl::get_column()).
+
+    void get_column_values(const std::vector<ConfigObject>& objects, const attribute_t& attribute, std::vector<attribute_value_t>& values);
+
     template<class T>
     void
     set_cache_unread(const std::vector<std::string>& objects, Cache<T>& c) noexcept
     {
       for (const auto& i : objects)
         {
-          // unread template objects
-          auto x = c.m_cache.find(i);
+          const std::string * id = find_id(i);
+          if (id == nullptr)
+            continue;
+
+          // unread template objects; they are marked outdated atomically and re-read by check_init() on next access
+          auto x = c.m_cache.find(id);
           if (x != c.m_cache.end())
-            {
-              std::lock_guard<std::mutex> scoped_lock(x->second->m_mutex);
-              x->second->p_was_read = false;
-            }
+            x->second->set_outdated();
 
           // unread generated objects if any
-          auto range = c.m_t_cache.equal_range(i);
+          auto range = c.m_t_cache.equal_range(id);
           for (auto it = range.first; it != range.second; it++)
-            {
-              std::lock_guard<std::mutex> scoped_lock(it->second->m_mutex);
-              it->second->p_was_read = false;
-            }
+            it->second->set_outdated();
         }
     }
 
@@ -1625,6 +2329,8 @@ class Configuration {
     std::string m_impl_name;
     std::string m_impl_param;
     void * m_shlib_h;
+    ConfigurationImpl * (*m_impl_creator)(const std::string& spec);
+    ConfigurationImpl * m_snapshot_impl;  // the snapshot replaced by the plug-in (see leave_snapshot_cache())
 
 
     // user notification
@@ -1664,9 +2370,12 @@ class Configuration {
   private:
 
     mutable std::mutex m_impl_mutex;  // mutex used to access implementation objects (i.e. ConfigObjectImpl objects)
-    mutable std::mutex m_tmpl_mutex;  // mutex used to access template objects (i.e. generated DAL)
+    mutable std::shared_mutex m_tmpl_mutex;  // mutex used to access template objects (i.e. generated DAL); cache hits lock it in shared mode, any insertion in exclusive mode
+    mutable std::shared_mutex m_update_mutex;  // locked after the m_tmpl_mutex: exclusively by system_cb() applying changes, in shared mode by shared owners of m_tmpl_mutex reading implementation objects
     mutable std::mutex m_actn_mutex;  // mutex is used to access actions
     mutable std::mutex m_else_mutex;  // mutex used to access subscription, attribute converter, etc. objects
+    mutable std::mutex m_desc_mutex;  // mutex used to access cache of class descriptions; it is locked after the m_impl_mutex
+    mutable std::mutex m_index_mutex;  // mutex used to access attribute value indices; it is locked after the m_impl_mutex
 
 
     // prevent copy constructor and operator=
@@ -1710,7 +2419,7 @@ template<class T>
   {
     ConfigObject obj;
 
-    std::lock_guard<std::mutex> scoped_lock(m_tmpl_mutex);
+    std::lock_guard<std::shared_mutex> scoped_lock(m_tmpl_mutex);
     create(at, T::s_class_name, id, obj);
     return get_cache<T>()->get(*this, obj, false, init_object);
   }
@@ -1726,7 +2435,7 @@ template<class T>
 // Get object of given class and instantiate the template parameter with it.
 template<class T>
   const T *
-  Configuration::_get(const std::string& name, bool init_children, bool init_object, unsigned long rlevel, const std::vector<std::string> * rclasses)
+  Configuration::_get(std::string_view name, bool init_children, bool init_object, unsigned long rlevel, const std::vector<std::string> * rclasses)
   {
     return get_cache<T>()->get(*this, name, init_children, init_object, rlevel, rclasses);
   }
@@ -1748,10 +2457,35 @@ template<class T>
 
 template<class T>
   const T *
-  Configuration::_find(const std::string& id)
+  Configuration::_find(std::string_view id)
+  {
+    auto it = m_cache_map.find(&T::s_class_name);
+    if (it == m_cache_map.end())
+      return nullptr;
+
+    const std::string * x = find_id(id);
+    return (x != nullptr ? static_cast<Cache<T>*>(it->second)->find(x) : nullptr);
+  }
+
+template<class T>
+  const T *
+  Configuration::_find_cached(std::string_view id) noexcept
+  {
+    if (const T * obj = _find<T>(id))
+      {
+        ++p_number_of_cache_hits;
+        return obj;
+      }
+
+    return nullptr;
+  }
+
+template<class T>
+  const T *
+  Configuration::_find_cached(ConfigObject& obj, const std::string * id) noexcept
   {
     auto it = m_cache_map.find(&T::s_class_name);
-    return (it != m_cache_map.end() ? static_cast<Cache<T>*>(it->second)->find(id) : nullptr);
+    return (it != m_cache_map.end() ? static_cast<Cache<T>*>(it->second)->find(*this, obj, id) : nullptr);
   }
 
 // Get all objects the given class and instantiate a vector of the template parameters object with it.
@@ -1763,7 +2497,8 @@ template<class T>
 
     try
       {
-        get(T::s_class_name, objs, query, rlevel, rclasses);
+        std::lock_guard<std::mutex> scoped_lock(m_impl_mutex);
+        _get(T::s_class_name, objs, query, rlevel, rclasses);
       }
     catch (dunedaq::conffwk::NotFound & ex)
       {
@@ -1791,17 +2526,8 @@ template<class T>
   Configuration::_ref(ConfigObject& obj, const std::string& name, bool read_children)
   {
     ConfigObject res;
-
-    try
-      {
-        obj.get(name, res);
-      }
-    catch (dunedaq::conffwk::Generic & ex)
-      {
-        throw(dunedaq::conffwk::Generic( ERS_HERE, mk_ref_ex_text("an object", T::s_class_name, name, obj).c_str(), ex ) );
-      }
-
-    return ((!res.is_null()) ? get_cache<T>()->get(*this, res, read_children, read_children) : nullptr);
+    _read_ref(obj, name, T::s_class_name, res);
+    return ((!res.is_null()) ? _get_ref<T>(res, read_children) : nullptr);
   }
 
 
@@ -1821,7 +2547,7 @@ template<class T>
 
         for (auto& i : objs)
           {
-            results.push_back(get_cache<T>()->get(*this, i, read_children, read_children));
+            results.push_back(_get_ref<T>(i, read_children));
           }
       }
     catch (dunedaq::conffwk::Generic & ex)
@@ -1830,6 +2556,22 @@ template<class T>
       }
   }
 
+template<class T>
+  const T *
+  Configuration::_get_ref(ConfigObject& obj, bool read_children)
+  {
+    if (s_shared_init == this)
+      {
+        if (read_children == false)
+          if (const T * x = _find_cached<T>(obj, obj.m_impl->m_id_ptr))
+            return x;
+
+        throw exclusive_lock_required();
+      }
+
+    return get_cache<T>()->get(*this, obj, read_children, read_children);
+  }
+
 template<class T, class V>
   void
   Configuration::referenced_by(const T& obj, std::vector<const V*>& results, const std::string& relationship_name, bool check_composite_only, bool init, unsigned long rlevel, const std::vector<std::string> * rclasses)
@@ -1838,7 +2580,7 @@ template<class T, class V>
 
     results.clear();
 
-    std::lock_guard<std::mutex> scoped_lock(m_tmpl_mutex);
+    std::lock_guard<std::shared_mutex> scoped_lock(m_tmpl_mutex);
 
     try
       {
@@ -1846,7 +2588,7 @@ template<class T, class V>
 
         for (auto& i : objs)
           {
-            if (try_cast(V::s_class_name, i.class_name()) == true)
+            if (try_cast(&V::s_class_name, i.m_impl) == true)
               {
                 if (const V * o = get_cache<V>()->get(*this, i, init, init))
                   {
@@ -1865,10 +2607,31 @@ template<class T, class V>
 template<class T>
   Configuration::Cache<T>::~Cache() noexcept
   {
-    // delete each object in cache
+    // destroy each object in cache; the memory is released by the pool at once
     for (const auto& i : m_cache)
       {
-        delete i.second;
+        i.second->~T();
+      }
+  }
+
+
+template<class T>
+  T *
+  Configuration::Cache<T>::create(Configuration& conffwk, ConfigObject& obj)
+  {
+    void * p = m_pool.allocate();
+
+    try
+      {
+        T * x = new (p) T(conffwk, obj);
+        x->p_class_generation = &m_generation;
+        x->p_generation = x->current_generation();
+        return x;
+      }
+    catch (...)
+      {
+        m_pool.deallocate(p);
+        throw;
       }
   }
 
@@ -1878,10 +2641,23 @@ template<class T>
 Configuration::Cache<T>::get(Configuration& conffwk,
                              ConfigObject& obj, bool init_children, bool init_object)
   {
-    T*& result(m_cache[obj.m_impl->m_id]);
+    // do not keep reference on the cache element: the init() may insert other objects and grow the cache
+    auto i = m_cache.try_emplace(obj.m_impl->m_id_ptr, nullptr);
+    T * result = i.first->second;
     if (result == nullptr)
       {
-        result = new T(conffwk, obj);
+        try
+          {
+            result = create(conffwk, obj);
+          }
+        catch (...)
+          {
+            m_cache.erase(i.first);
+            throw;
+          }
+
+        i.first->second = result;
+
         if (init_object)
           {
             std::lock_guard<std::mutex> scoped_lock(result->m_mutex);
@@ -1899,24 +2675,57 @@ Configuration::Cache<T>::get(Configuration& conffwk,
 
 template<class T>
   T *
-  Configuration::Cache<T>::find(const std::string& id)
+  Configuration::Cache<T>::find(const std::string * id)
   {
     auto it = m_cache.find(id);
     return (it != m_cache.end() ? it->second : nullptr);
   }
 
+template<class T>
+  T *
+  Configuration::Cache<T>::find(Configuration& conffwk, ConfigObject& obj, const std::string * id) noexcept
+  {
+    auto it = m_cache.find(id);
+
+    if (it == m_cache.end())
+      return nullptr;
+
+    T * result = it->second;
+
+    // the implementation object is only replaced by exclusive owner of template objects mutex (see get())
+
+    if (obj.m_impl != result->p_obj.m_impl)
+      return nullptr;
+
+    increment_gets(conffwk);
+    return result;
+  }
+
 template<class T>
   T *
   Configuration::Cache<T>::get(Configuration& db, ConfigObject& obj, const std::string& id)
   {
-    T*& result(m_cache[id]);
+    const std::string * uid = &db.intern_id(id);
+    auto i = m_cache.try_emplace(uid, nullptr);
+    T * result = i.first->second;
     if (result == nullptr)
       {
-        result = new T(db, obj);
-        if (id != obj.UID())
+        try
           {
-            result->p_UID = id;
-            m_t_cache.emplace(obj.UID(), result);
+            result = create(db, obj);
+          }
+        catch (...)
+          {
+            m_cache.erase(i.first);
+            throw;
+          }
+
+        i.first->second = result;
+
+        if (uid != obj.m_impl->m_id_ptr)
+          {
+            result->p_UID_ptr = uid;
+            m_t_cache.emplace(obj.m_impl->m_id_ptr, result);
           }
       }
     else if(obj.m_impl != result->p_obj.m_impl)
@@ -1932,13 +2741,14 @@ template<class T>
   // Get object from cache or create it.
 
 template<class T> T *
-Configuration::Cache<T>::get(Configuration& conffwk, const std::string& name, bool init_children, bool init_object, unsigned long rlevel, const std::vector<std::string> * rclasses)
+Configuration::Cache<T>::get(Configuration& conffwk, std::string_view name, bool init_children, bool init_object, unsigned long rlevel, const std::vector<std::string> * rclasses)
 {
-  typename conffwk::map<T*>::iterator i = m_cache.find(name);
+  const std::string * id = conffwk.find_id(name);
+  auto i = (id ? m_cache.find(id) : m_cache.end());
   if(i == m_cache.end()) {
     try {
       ConfigObject obj;
-      conffwk._get(T::s_class_name, name, obj, rlevel, rclasses);
+      conffwk._get(T::s_class_name, std::string(name), obj, rlevel, rclasses);
       return get(conffwk, obj, init_children, init_object);
     }
     catch(dunedaq::conffwk::NotFound & ex) {
@@ -1961,7 +2771,7 @@ template<class T>
   bool
   Configuration::is_valid(const T * object) noexcept
   {
-    std::lock_guard<std::mutex> scoped_lock(m_tmpl_mutex);
+    std::shared_lock<std::shared_mutex> scoped_lock(m_tmpl_mutex);
 
     auto j = m_cache_map.find(&T::s_class_name);
 
@@ -1971,7 +2781,7 @@ template<class T>
 
         for (const auto& i : c->m_cache)
           {
-            if (i->second == object)
+            if (i.second == object)
               return true;
           }
       }
@@ -2005,20 +2815,47 @@ Configuration::_reset_objects() noexcept
 
     if (j != m_cache_map.end())
       {
-        _unread_objects(static_cast<Cache<T>*>(j->second));
+        _unread_objects<T>(j->second);
       }
   }
 
 template<class T>
   void
   Configuration::_unread_objects(CacheBase* x) noexcept
+  {
+    // the objects with outdated generation are re-read by DalObject::check_init()
+    x->m_generation++;
+  }
+
+template<class T>
+  void
+  Configuration::_rebind_objects(Configuration& db, CacheBase* x) noexcept
   {
     Cache<T> *c = static_cast<Cache<T>*>(x);
 
+    // generated objects are stored in the main cache as well; they are bound to the objects they were generated from
     for (auto& i : c->m_cache)
-      {
-        i.second->p_was_read = false;
-      }
+      db.rebind_template_object(*i.second);
+
+    // the objects are re-read from the new implementation objects by DalObject::check_init()
+    x->m_generation++;
+  }
+
+template<class T>
+  void
+  Configuration::_memory_usage(const CacheBase* x, memory_usage_t& usage) noexcept
+  {
+    const Cache<T> *c = static_cast<const Cache<T>*>(x);
+
+    // generated objects are stored in the main cache as well
+    const std::size_t num = c->m_cache.size() - c->m_t_cache.size();
+    const std::size_t block = c->m_pool.block_size();
+
+    usage.p_dal_objects += num;
+    usage.p_dal_bytes += num * block + c->m_cache.capacity() * (sizeof(typename decltype(c->m_cache)::value_type) + 1);
+
+    usage.p_generated_objects += c->m_t_cache.size();
+    usage.p_generated_bytes += c->m_t_cache.size() * (block + sizeof(typename decltype(c->m_t_cache)::value_type) + sizeof(void*)) + c->m_t_cache.bucket_count() * sizeof(void*);
   }
 
 template<class T> void
@@ -2026,51 +2863,123 @@ Configuration::_rename_object(CacheBase* x, const std::string& old_id, const std
 {
   Cache<T> *c = static_cast<Cache<T>*>(x);
 
+  // the IDs are interned, use their addresses as keys
+  const std::string * old_uid = &old_id;
+  const std::string * new_uid = &new_id;
+
   // rename template object
-  auto it = c->m_cache.find(old_id);
+  auto it = c->m_cache.find(old_uid);
   if (it != c->m_cache.end())
     {
       TLOG_DEBUG(3) << " * rename \'" << old_id << "\' to \'" << new_id << "\' in class \'" << T::s_class_name << "\')";
-      c->m_cache[new_id] = it->second;
+      T * o = it->second;
       c->m_cache.erase(it);
+      c->m_cache[new_uid] = o;
 
-      std::lock_guard<std::mutex> scoped_lock(it->second->m_mutex);
-      it->second->p_UID = new_id;
+      std::lock_guard<std::mutex> scoped_lock(o->m_mutex);
+      o->p_UID_ptr = new_uid;
     }
 
   // rename generated objects if any
-  auto range = c->m_t_cache.equal_range(old_id);
-  for (auto it = range.first; it != range.second;)
-    {
-      T * o = it->second;
-      it = c->m_t_cache.erase(it);
-      c->m_t_cache.emplace(new_id, o);
-    }
+  std::vector<T *> objs;
+  auto range = c->m_t_cache.equal_range(old_uid);
+  for (auto it = range.first; it != range.second; ++it)
+    objs.push_back(it->second);
+
+  c->m_t_cache.erase(old_uid);
+
+  for (auto& o : objs)
+    c->m_t_cache.emplace(new_uid, o);
 }
 
 
+template<class T>
+  void
+  Configuration::get_column(const std::string& class_name, const std::string& attribute, std::vector<T>& values, std::vector<ConfigObject> * objs)
+  {
+    const AttributeHandle handle(get_attribute_handle(class_name, attribute));
+
+    std::vector<ConfigObject> objects;
+    get(class_name, objects);
+
+    std::vector<attribute_value_t> column;
+    get_column_values(objects, *handle.p_attribute, column);
+
+    const bool has_converters = m_has_converters.load(std::memory_order_relaxed);
+
+    values.clear();
+    values.reserve(objects.size());
+
+    for (std::size_t i = 0; i < objects.size(); ++i)
+      {
+        T * value = std::get_if<T>(&column[i]);
+
+        if (value == nullptr)
+          {
+            std::ostringstream text;
+            text << "the type of value of attribute \'" << attribute << "\' of class \'" << class_name << "\' differs from the requested one";
+            throw dunedaq::conffwk::Generic(ERS_HERE, text.str().c_str());
+          }
+
+        if (has_converters)
+          objects[i].m_impl->convert(*value, objects[i], attribute);
+
+        values.push_back(std::move(*value));
+      }
+
+    if (objs)
+      objs->swap(objects);
+  }
+
+template<class T>
+  constexpr std::size_t
+  Configuration::converter_slot() noexcept
+  {
+    if constexpr (std::is_same_v<T, bool>) return bool_type;
+    else if constexpr (std::is_same_v<T, int8_t>) return s8_type;
+    else if constexpr (std::is_same_v<T, uint8_t>) return u8_type;
+    else if constexpr (std::is_same_v<T, int16_t>) return s16_type;
+    else if constexpr (std::is_same_v<T, uint16_t>) return u16_type;
+    else if constexpr (std::is_same_v<T, int32_t>) return s32_type;
+    else if constexpr (std::is_same_v<T, uint32_t>) return u32_type;
+    else if constexpr (std::is_same_v<T, int64_t>) return s64_type;
+    else if constexpr (std::is_same_v<T, uint64_t>) return u64_type;
+    else if constexpr (std::is_same_v<T, float>) return float_type;
+    else if constexpr (std::is_same_v<T, double>) return double_type;
+    else
+      {
+        static_assert(std::is_same_v<T, std::string>, "unsupported type of attribute converter");
+        return string_type;
+      }
+  }
+
 template<class T> void
 Configuration::register_converter(AttributeConverter<T> * object) noexcept
   {
     std::lock_guard<std::mutex> scoped_lock(m_else_mutex);
 
-    std::list<AttributeConverterBase*> * c = m_convert_map[typeid(T).name()];
-    if (c == 0)
-      {
-        c = m_convert_map[typeid(T).name()] = new std::list<AttributeConverterBase*>();
-      }
+    std::atomic<const converters_t *>& slot(m_converters[converter_slot<T>()]);
 
+    const converters_t * l = slot.load(std::memory_order_relaxed);
+    std::unique_ptr<converters_t> c(l ? new converters_t(*l) : new converters_t());
     c->push_back(object);
+
+    slot.store(c.get(), std::memory_order_release);
+    m_converters_lists.emplace_back(std::move(c));
+
+    m_has_converters.store(true, std::memory_order_release);
   }
 
 template<class T>
   void
   Configuration::convert(T& value, const ConfigObject& obj, const std::string& attr_name) noexcept
   {
-    conffwk::map<std::list<AttributeConverterBase*> *>::const_iterator l = m_convert_map.find(typeid(T).name());
-    if (l != m_convert_map.end())
+    if (m_has_converters.load(std::memory_order_relaxed) == false)
+      return;
+
+    if (const converters_t * l = m_converters[converter_slot<T>()].load(std::memory_order_acquire))
       {
-        for (const auto& i : *l->second)
+        for (const auto& i : *l)
           {
             static_cast<AttributeConverter<T>*>(i)->convert(value, *this, obj, attr_name);
           }
@@ -2081,12 +2990,14 @@ template<class T>
   void
   Configuration::convert2(std::vector<T>& value, const ConfigObject& obj, const std::string& attr_name) noexcept
   {
-    conffwk::map<std::list<AttributeConverterBase*> *>::const_iterator l = m_convert_map.find(typeid(T).name());
-    if (l != m_convert_map.end())
+    if (m_has_converters.load(std::memory_order_relaxed) == false)
+      return;
+
+    if (const converters_t * l = m_converters[converter_slot<T>()].load(std::memory_order_acquire))
       {
         for (auto& j : value)
           {
-            for (const auto& i : *l->second)
+            for (const auto& i : *l)
               {
                 static_cast<AttributeConverter<T>*>(i)->convert(j, *this, obj, attr_name);
               }
@@ -8,14 +8,25 @@
 #ifndef CONFFWK_CONFIGURATIONIMPL_H_
 #define CONFFWK_CONFIGURATIONIMPL_H_
 
+#include <array>
+#include <atomic>
+#include <cstdint>
 #include <string>
 #include <vector>
 #include <list>
 #include <set>
 #include <map>
+#include <mutex>
+#include <typeindex>
+#include <typeinfo>
+#include <unordered_map>
+#include <unordered_set>
 
 #include "conffwk/map.hpp"
+#include "conffwk/pool.hpp"
+#include "conffwk/ConfigObjectImpl.hpp"
 #include "conffwk/set.hpp"
+#include "conffwk/string_table.hpp"
 #include "conffwk/ConfigVersion.hpp"
 
 class ConfigurationChange;
@@ -113,6 +124,22 @@ class ConfigurationImpl {
 
     virtual void prefetch_all_data() = 0;
 
+      /**
+       *  Prefetch given objects into client cache (class name -> object IDs), e.g. the ones of an access trace.
+       *  The objects, which are already in the cache or do not exist anymore, are ignored.
+       *  The default implementation reads objects one by one; an implementation can override it to read them in bulk.
+       */
+
+    virtual void prefetch(const std::map<std::string, std::vector<std::string>>& objects);
+
+      /**
+       *  Read values of attribute of given objects into the values (in order of objects), e.g. for Configuration::get_column().
+       *  The objects are of class of the attribute description or of its subclasses.
+       *  The default implementation reads values object by object; an implementation can override it to read them in one pass.
+       */
+
+    virtual void get_column(const std::vector<ConfigObject>& objects, const attribute_t& attribute, std::vector<attribute_value_t>& values);
+
       /// Get newly available versions
 
     virtual std::vector<dunedaq::conffwk::Version> get_changes() = 0;
@@ -202,15 +229,194 @@ class ConfigurationImpl {
     void print_cache_info() noexcept;
 
 
-      /// cache of implementation objects (class-name::->object_id->implementation)
+      /// interned object IDs; the implementation and template objects caches use pointers on them as keys
 
   private:
 
-    conffwk::pmap<conffwk::map<ConfigObjectImpl *> * > m_impl_objects;
-    std::vector<ConfigObjectImpl *> m_tangled_objects; // deleted and replaced by others as result of rename
+    conffwk::string_table m_ids;
+
+      /**
+       *  The cache of implementation objects is split into shards selected by class name, each protected by own mutex.
+       *  The maps of a shard are modified only by the owner of the Configuration implementation mutex, who locks the shard
+       *  (to change objects of several classes, all shards are locked in order, see shards_lock); they are read either
+       *  by the owner of the Configuration implementation mutex, or by the owner of the shard mutex (the cache hit path).
+       *  A shard mutex is never locked before the Configuration mutexes or together with another single shard mutex.
+       */
+
+    struct impl_objects_shard
+    {
+      mutable std::mutex m_mutex;
+
+        /// cache of implementation objects (class-name::->object_id->implementation); the class name is the pointer interned by the DalFactory
+
+      conffwk::fmap<conffwk::fmap<ConfigObjectImpl *> * > m_objects;
+
+        /// index of implementation objects by superclass (superclass-name::->object_id->implementation of subclass object), so a polymorphic lookup is a single probe
+
+      conffwk::fmap<conffwk::fmap<ConfigObjectImpl *> * > m_subclasses_objects;
+
+        /// number of cache hits; counted per shard to avoid contention on a single counter
+
+      mutable unsigned long m_hits = 0;
+
+        /// return true, if the class name is a key of the shard maps, i.e. it is the pointer interned by the DalFactory
+
+      bool
+      has(const std::string * class_name) const noexcept
+      {
+        return (m_objects.find(class_name) != m_objects.end() || m_subclasses_objects.find(class_name) != m_subclasses_objects.end());
+      }
+
+        /// find object of class or of its subclass
+
+      ConfigObjectImpl * find(const std::string * class_name, const std::string * id) const noexcept;
+    };
+
+      /// lock all shards, e.g. to rename or to remove objects, which may be found via shards of their superclasses
+
+    struct shards_lock
+    {
+      shards_lock(const ConfigurationImpl& impl) noexcept : m_impl(impl)
+      {
+        for (auto& x : m_impl.m_shards)
+          x.m_mutex.lock();
+      }
+
+      ~shards_lock() noexcept
+      {
+        for (auto x = m_impl.m_shards.rbegin(); x != m_impl.m_shards.rend(); ++x)
+          x->m_mutex.unlock();
+      }
+
+      const ConfigurationImpl& m_impl;
+    };
+
+    static constexpr std::size_t s_num_of_shards = 16;
+
+    std::array<impl_objects_shard, s_num_of_shards> m_shards;
+
+    impl_objects_shard&
+    shard(const std::string * class_name) noexcept
+    {
+      return m_shards[shard_index(class_name)];
+    }
+
+    const impl_objects_shard&
+    shard(const std::string * class_name) const noexcept
+    {
+      return m_shards[shard_index(class_name)];
+    }
+
+    static std::size_t
+    shard_index(const std::string * class_name) noexcept
+    {
+      // the interned names are allocated by the DalFactory at addresses aligned by at least 8 bytes
+      const std::uintptr_t x = reinterpret_cast<std::uintptr_t>(class_name) >> 3;
+      return (x ^ (x >> 5) ^ (x >> 11)) % s_num_of_shards;
+    }
+
+    std::vector<ConfigObjectImpl *> m_tangled_objects; // deleted and replaced by others as result of rename; reclaimed by reclaim_tangled_objects()
+
+      /// memory pools of implementation objects (one per implementation type), released at once by clean()
+
+    std::unordered_map<std::type_index, conffwk::pool *> m_impl_pools;
+
+      /// generation of implementation objects: the unread increments it and sets the state applied lazily to objects of older generations (see ConfigObjectImpl::check_generation())
+
+    std::atomic<unsigned long> m_generation;
+    std::atomic<dunedaq::conffwk::ObjectState> m_unread_state;
+
+    unsigned long p_number_of_object_read;
+
+
+      /// optional limit of implementation objects cache size in bytes (0 means no limit); the least recently used objects without ConfigObject handles are evicted
+
+    std::atomic<std::size_t> m_cache_limit;
+    std::atomic<std::size_t> m_cache_size;
+    std::atomic<unsigned long> m_cache_clock;  // LRU time: advanced by put_impl_object(), the cache hits only read it
+    conffwk::fset m_evicted_ids;   // to count re-read objects; the ID is removed, when the object is re-read
+    unsigned long p_number_of_evicted_objects;
+    unsigned long p_number_of_reread_objects;
+
+
+      /// accessed objects evicted from cache (class name -> object IDs), they are kept by the access trace; protected by the Configuration implementation mutex
+      /// the ID is removed, when the object is re-read (the accessed state is moved to the new object)
+
+    conffwk::fmap<conffwk::fset> m_evicted_accessed;
+    std::size_t m_number_of_evicted_accessed;
+
+
+      /// maximum number of IDs in the above sets, so the bookkeeping of evicted objects does not grow with every object ever read;
+      /// above it the number of re-read objects is not counted and the access trace misses evicted objects
+
+    static constexpr std::size_t s_max_evicted_ids = 65536;
+
+
+      /// the objects read or found in cache by the thread are not marked as accessed while an untraced_scope exists (used by prefetch of objects)
+
+    struct untraced_scope
+    {
+      untraced_scope() noexcept { ++s_untraced; }
+      ~untraced_scope() noexcept { --s_untraced; }
+      untraced_scope(const untraced_scope&) = delete;
+      untraced_scope& operator=(const untraced_scope&) = delete;
+    };
+
+    static inline thread_local unsigned int s_untraced = 0;
+
+
+      /// mark object as accessed by user request, unless it is read by prefetch (see Configuration::save_access_trace())
+
+    static void
+    mark_accessed(ConfigObjectImpl * obj) noexcept;
 
-    mutable unsigned long p_number_of_cache_hits;
-    mutable unsigned long p_number_of_object_read;
+
+      /// set cache limit in bytes (0 means no limit)
+
+    void set_cache_limit(std::size_t limit) noexcept;
+
+      /// evict least recently used objects, if the cache exceeds the limit; the caller has to lock both template and implementation objects mutexes
+
+    void evict_impl_objects() noexcept;
+
+      /// remove least recently used object from cache and destroy it; the caller has to lock all shards
+
+    void evict_impl_object(ConfigObjectImpl * obj) noexcept;
+
+      /// remove object from cache and destroy it without bookkeeping of evicted objects; the caller has to lock all shards
+
+    void remove_impl_object(ConfigObjectImpl * obj) noexcept;
+
+      /// get objects in cache, e.g. to release the objects read temporarily by release_impl_objects()
+
+    std::unordered_set<const ConfigObjectImpl *> cached_impl_objects() const;
+
+      /// remove from cache and destroy objects, which are not referenced by ConfigObject handles and are not in given set; the caller has to lock the Configuration implementation mutex
+
+    void release_impl_objects(const std::unordered_set<const ConfigObjectImpl *>& keep) noexcept;
+
+      /**
+       *  Destroy tangled objects, which are not referenced by ConfigObject handles anymore.
+       *  A tangled object is removed from the shards, so no new handle can be created on it via the cache hit path;
+       *  the object is reclaimed once all readers, who got a handle before it was replaced, have released their handles.
+       *  The caller has to lock the template objects mutex in exclusive mode or the update mutex in exclusive mode (the shared owners of the
+       *  template objects mutex using implementation objects without handles lock the update mutex), and the Configuration implementation mutex.
+       */
+
+    void reclaim_tangled_objects() noexcept;
+
+
+      /// get class name interned by the DalFactory
+
+    const std::string * get_class_name(const std::string& name) const noexcept;
+
+      /// find object in cache; if the handle is provided, the valid object is only returned and the handle is set under shard lock (i.e. the object cannot be evicted)
+
+    ConfigObjectImpl * find_impl_object(const std::string& class_name, const std::string * id, ConfigObject * handle) const noexcept;
+
+      /// add object to the index of every superclass of its class; lock the shard of each superclass, unless all shards are already locked by the caller
+
+    void index_impl_object(const conffwk::fmap<conffwk::fset>& superclasses, ConfigObjectImpl * obj, bool lock) noexcept;
 
 
   protected:
@@ -220,39 +426,87 @@ class ConfigurationImpl {
     ConfigObjectImpl * get_impl_object(const std::string& class_name, const std::string& id) const noexcept;
 
 
+      /// get valid up-to-date object from cache without locking the Configuration implementation mutex; return false, if there is no such object
+
+    bool get_cached_object(const std::string& class_name, const std::string& id, ConfigObject * object) const noexcept;
+
+
       /// put object to cache
 
     void put_impl_object(const std::string& class_name, const std::string& id, ConfigObjectImpl * obj) noexcept;
 
 
-      /// insert new object (update cache or create-and-insert)
+      /// get memory pool for implementation objects of given type
+
+    conffwk::pool& get_impl_pool(const std::type_info& type, std::size_t size);
+
+
+      /**
+       *  Insert new object (update cache or create-and-insert); the object is allocated in the pool.
+       *
+       *  The method is called by plug-ins resolving relationships, also by several threads initializing template
+       *  objects in parallel (see DalObject::check_init()), so the calls are serialized by the m_insert_mutex.
+       *  The found object is only updated, if it is not valid or has pending unread; the update is done under
+       *  the object's mutex, while an up-to-date object is returned without locking it (the plug-in may own
+       *  the mutex of the object referencing this one, which may be the same object).
+       */
 
     template<class T, class OBJ>
       T *
       insert_object(OBJ& obj, const std::string& id, const std::string& class_name) noexcept
         {
+          std::lock_guard<std::mutex> scoped_lock(m_insert_mutex);
+
           ConfigObjectImpl * p = get_impl_object(class_name, id);
 
           if (p == nullptr)
             {
-              p = static_cast<ConfigObjectImpl *>(new T(obj, this));
+              conffwk::pool& pool = get_impl_pool(typeid(T), sizeof(T));
+              p = static_cast<ConfigObjectImpl *>(new (pool.allocate()) T(obj, this));
+              p->m_pool = &pool;
               put_impl_object(class_name, id, p);
             }
-          else
+          else if (!is_up_to_date(p))
             {
-              static_cast<T *>(p)->set(obj);
-              p->m_state = dunedaq::conffwk::Valid;
+              std::lock_guard<std::mutex> scoped_lock2(p->m_mutex);
+
+              // another thread might reset the object before its mutex was locked
+              if (!is_up_to_date(p))
+                {
+                  static_cast<T *>(p)->set(obj);
+                  p->m_state = dunedaq::conffwk::Valid;
+                  p->m_generation = m_generation.load();  // the object is up to date, cancel pending unread
+                }
             }
 
           return static_cast<T *>(p);
         }
 
 
+      /// return true, if the object is valid and has no pending unread
+
+    bool
+    is_up_to_date(const ConfigObjectImpl * obj) const noexcept
+    {
+      return (obj->m_state == dunedaq::conffwk::Valid && obj->m_generation.load(std::memory_order_acquire) == m_generation.load(std::memory_order_acquire));
+    }
+
+
+      /// serializes insert_object() calls: it updates the cache, the memory pools and the counters
+
+    std::mutex m_insert_mutex;
+
+
       /// clean cache (e.g. to be used by destructor)
 
     void clean() noexcept;
 
 
+      /// destroy implementation object and return its memory to the pool
+
+    void destroy_impl_object(ConfigObjectImpl * obj) noexcept;
+
+
       /// Configuration pointer is needed for notification on changes, e.g. in case of subscription or an object deletion
 
   protected:
@@ -265,6 +519,18 @@ class ConfigurationImpl {
     std::mutex& get_conf_impl_mutex() const;
 
 
+  public:
+
+      /// get interned object ID
+
+    const std::string& intern_id(std::string_view id) { return m_ids.intern(id); }
+
+
+      /// get interned object ID or nullptr, if there is no such ID
+
+    const std::string * find_id(std::string_view id) const noexcept { return m_ids.find(id); }
+
+
   public:
 
       /// set configuration object
@@ -274,6 +540,10 @@ class ConfigurationImpl {
 
   public:
 
+      /// rebuild index of subclass objects (e.g. after schema change)
+
+    void reindex_impl_objects(const conffwk::fmap<conffwk::fset>& superclasses) noexcept;
+
       /// rename object in cache
 
     void rename_impl_object(const std::string * class_name, const std::string& old_id, const std::string& new_id) noexcept;
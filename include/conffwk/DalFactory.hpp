@@ -4,10 +4,12 @@
 #include <map>
 #include <mutex>
 #include <string>
+#include <string_view>
 
 #include "ers/ers.hpp"
 
 #include "conffwk/set.hpp"
+#include "conffwk/string_table.hpp"
 #include "conffwk/DalFactoryFunctions.hpp"
 
 #include "logging/Logging.hpp"
@@ -39,11 +41,25 @@ public:
         }
     }
 
+  /** get class name interned by the factory; the pointers to interned names are used as keys of caches (no lock, if the name is already interned) */
   const std::string&
-  get_known_class_name_ref(const std::string& name)
+  get_known_class_name_ref(std::string_view name)
   {
-    std::lock_guard<std::mutex> scoped_lock(m_known_class_mutex);
-    return *m_known_classes.emplace(name).first;
+    return m_known_classes.intern(name);
+  }
+
+  /** same as get_known_class_name_ref(), but returns pointer */
+  const std::string *
+  get_known_class_name_ptr(std::string_view name)
+  {
+    return &m_known_classes.intern(name);
+  }
+
+  /** get interned class name or nullptr, if the name was never interned (never locks) */
+  const std::string *
+  find_known_class_name(std::string_view name) const noexcept
+  {
+    return m_known_classes.find(name);
   }
 
 
@@ -79,9 +95,27 @@ public:
   functions(const Configuration& db, const std::string& name, bool upcast_unregistered) const;
 
 
+  /**
+   * \brief Get DAL class implementing algorithm for objects of given class
+   *
+   * The result is cached by the configuration database object until its schema is changed (e.g. by load() or unload()).
+   *
+   * \param db                    configuration database object
+   * \param name                  name of OKS class
+   * \param algorithm             name of algorithm
+   * \return                      name of DAL class or empty string, if there is no suitable class
+   */
+
   const std::string&
   class4algo(Configuration& db, const std::string& name, const std::string& algorithm) const;
 
+  /**
+   * \brief Same as class4algo(), but checks all registered DAL classes without using the cache
+   */
+
+  const std::string&
+  find_class4algo(Configuration& db, const std::string& name, const std::string& algorithm) const;
+
   /**
    * \brief Get factory function
    *
@@ -98,8 +132,7 @@ private:
   std::mutex m_class_mutex;
   std::map<std::string, DalFactoryFunctions> m_classes;
 
-  std::mutex m_known_class_mutex;
-  conffwk::set m_known_classes;
+  conffwk::read_mostly_string_table m_known_classes;
 };
 
 } // namespace conffwk
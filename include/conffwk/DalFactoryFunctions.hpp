@@ -3,6 +3,7 @@
 
 #include <set>
 #include <string>
+#include <string_view>
 
 #include <boost/compute/functional/identity.hpp>
 
@@ -15,6 +16,7 @@ class ConfigObject;
 class ConfigurationChange;
 class DalObject;
 class CacheBase;
+struct memory_usage_t;
 
 
 /**
@@ -31,6 +33,19 @@ class CacheBase;
 typedef DalObject * (*dal_object_creator)(Configuration& db, ConfigObject& obj, const std::string& uid);
 
 
+/**
+ *  \brief The function gets DAL object of given template class by ID.
+ *
+ *  It calls Configuration::get<T>() or Configuration::find<T>() for class known by name only, e.g. by benchmarks.
+ *
+ *  \param db    reference on configuration
+ *  \param id    object ID
+ *  \return      the DAL object or nullptr, if there is no such object
+ */
+
+typedef const DalObject * (*dal_object_getter)(Configuration& db, std::string_view id);
+
+
 /**
  *  \brief The notification callback function which
  *  is invoked by database implementation in case of changes.
@@ -69,13 +84,41 @@ typedef void (*unread_object)(CacheBase* x);
 typedef void (*rename_object_f)(CacheBase* x, const std::string& old_id, const std::string& new_id);
 
 
+/**
+ *  \brief The function to add number and size of objects in cache.
+ *
+ *  \warning To be used by automatically generated libraries and should not be directly used by developers.
+ *
+ *  \param x         reference on configuration cache for class of objects
+ *  \param usage     memory usage of the class to be updated
+ */
+
+typedef void (*memory_usage_f)(const CacheBase* x, memory_usage_t& usage);
+
+
+/**
+ *  \brief The function to replace implementation objects of objects in cache by the ones of current implementation.
+ *
+ *  \warning To be used by automatically generated libraries and should not be directly used by developers.
+ *
+ *  \param conf      reference on configuration
+ *  \param x         reference on configuration cache for class of objects
+ */
+
+typedef void (*rebind_objects_f)(Configuration& conf, CacheBase* x);
+
+
 
 struct DalFactoryFunctions
 {
   notify2 m_update_fn;
   unread_object m_unread_object_fn;
   rename_object_f m_rename_object_fn;
+  memory_usage_f m_memory_usage_fn;
+  rebind_objects_f m_rebind_objects_fn;
   dal_object_creator m_creator_fn;
+  dal_object_getter m_get_fn;
+  dal_object_getter m_find_fn;
 
   std::set<std::string> m_algorithms;
 
@@ -8,6 +8,7 @@
 #ifndef CONFFWK_DAL_OBJECT_H_
 #define CONFFWK_DAL_OBJECT_H_
 
+#include <atomic>
 #include <iostream>
 #include <memory>
 #include <mutex>
@@ -38,6 +39,10 @@ namespace conffwk {
  *  - remove() mark object as deleted
  *  - was_removed() return state of object's removal
  *  - set() assign conffwk object
+ *
+ *  \note Incompatible change for generated code: the protected \b std::string \b p_UID member is
+ *  replaced by the \b p_UID_ptr pointer to the ID interned by the configuration implementation.
+ *  Read the ID via UID(); the pointer is re-assigned, when the object is renamed.
  */
 
 class DalObject
@@ -55,7 +60,7 @@ protected:
    */
 
   DalObject(Configuration& db, const ConfigObject& o) noexcept :
-    p_was_read(false), p_db(db), p_obj(o), p_UID(p_obj.UID())
+    p_was_read(false), p_db(db), p_obj(o), p_UID_ptr(&p_obj.UID()), p_class_generation(&s_no_generation), p_generation(current_generation())
     {
       increment_created();
     }
@@ -104,8 +109,8 @@ protected:
   /// Used to protect changes of DAL object
   mutable std::mutex m_mutex;
 
-  /// is true, if the object was read
-  bool p_was_read;
+  /// is true, if the object was read (it is tested by check_init() without locking the template objects mutex)
+  std::atomic<bool> p_was_read;
 
   /// Configuration object
   Configuration& p_db;
@@ -113,8 +118,30 @@ protected:
   /// Config object used by given template object
   ConfigObject p_obj;
 
-  /// Is used for template objects (see dqm_conffwk)
-  std::string p_UID;
+  /// Is used for template objects (see dqm_conffwk); the ID is interned by the configuration implementation, use UID() to get it
+  const std::string * p_UID_ptr;
+
+  /// Generation of template objects of this class (is set by the cache)
+  const std::atomic<unsigned long> * p_class_generation;
+
+  /// Generation of template objects the object was read at; the object is re-read, when it is outdated
+  std::atomic<unsigned long> p_generation;
+
+  /// Current generation of the object; it grows, when all template objects or objects of this class are unread
+  unsigned long current_generation() const noexcept
+    {
+      return p_db.m_generation.load(std::memory_order_acquire) + p_class_generation->load(std::memory_order_acquire);
+    }
+
+  /// Atomically mark the object as outdated without locking it; the object is re-read by check_init() on next access (the current generation never decreases)
+  void set_outdated() noexcept
+    {
+      p_generation.store(current_generation() - 1, std::memory_order_release);
+    }
+
+private:
+
+  static inline const std::atomic<unsigned long> s_no_generation{0};
 
 public:
 
@@ -124,7 +151,7 @@ public:
 
   const std::string& UID() const noexcept
     {
-      return p_UID;
+      return *p_UID_ptr;
     }
 
   /**
@@ -144,7 +171,7 @@ public:
 
   bool castable(const std::string& target) const noexcept
     {
-      return p_db.try_cast(target, *p_obj.m_impl->m_class_name);
+      return p_db.try_cast(DalFactory::instance().get_known_class_name_ptr(target), p_obj.m_impl);
     }
 
   /**
@@ -153,7 +180,7 @@ public:
 
   bool castable(const std::string * target) const noexcept
     {
-      return p_db.try_cast(target, p_obj.m_impl->m_class_name);
+      return p_db.try_cast(target, p_obj.m_impl);
     }
 
   /**
@@ -181,7 +208,7 @@ public:
   full_name() const noexcept
     {
       std::lock_guard<std::mutex> scoped_lock(m_mutex);
-      return (p_UID + '@' + class_name());
+      return (*p_UID_ptr + '@' + class_name());
     }
 
 
@@ -290,8 +317,12 @@ public:
       if(DalObject::is_null(this))
         {
           DalObject::p_null(s);
+          return s;
         }
-      else if(p_obj.m_impl->m_state != dunedaq::conffwk::Valid)
+
+      p_obj.m_impl->check_generation();
+
+      if(p_obj.m_impl->m_state != dunedaq::conffwk::Valid)
         {
           DalObject::p_rm(s);
         }
@@ -365,6 +396,18 @@ private:
       Configuration::_unread_objects<T>(x);
     }
 
+  template<typename T>
+  static void memory_usage(const CacheBase* x, memory_usage_t& usage) noexcept
+    {
+      Configuration::_memory_usage<T>(x, usage);
+    }
+
+  template<typename T>
+  static void rebind_objects(Configuration& db, CacheBase* x) noexcept
+    {
+      Configuration::_rebind_objects<T>(db, x);
+    }
+
   template<typename T>
     static DalObject *
     create_instance(Configuration& db, ConfigObject& obj, const std::string& uid)
@@ -372,6 +415,20 @@ private:
       return db._make_instance<T>(obj, uid);
     }
 
+  template<typename T>
+    static const DalObject *
+    get_instance(Configuration& db, std::string_view id)
+    {
+      return db.get<T>(id);
+    }
+
+  template<typename T>
+    static const DalObject *
+    find_instance(Configuration& db, std::string_view id)
+    {
+      return db.find<T>(id);
+    }
+
 protected:
 
   /**
@@ -380,13 +437,45 @@ protected:
    */
   virtual void init(bool init_children) = 0;
 
-  /// Check and initialize object if necessary
+  /**
+   *  Check and initialize object if necessary.
+   *
+   *  The caller owns the object's mutex (as the generated methods do), so the object is initialized once.
+   *  The object is initialized by shared owner of the template objects mutex, so independent objects are
+   *  initialized in parallel. The implementation objects referenced by relationships are resolved by plug-in
+   *  via ConfigurationImpl::insert_object(), which serializes such calls. If the initialization has to create
+   *  template objects it references, it is repeated by exclusive owner of the mutex. The database changes
+   *  are applied by exclusive owner of the update mutex (see Configuration::system_cb()), so they never
+   *  interleave with the initialization.
+   */
   void check_init() const
     {
-      if(!p_was_read)
+      const unsigned long generation = current_generation();
+
+      if(!p_was_read.load(std::memory_order_acquire) || p_generation.load(std::memory_order_acquire) != generation)
         {
-          std::lock_guard<std::mutex> scoped_lock(this->p_db.m_tmpl_mutex);
-          const_cast<DalObject*>(this)->init(false);
+          DalObject * self = const_cast<DalObject*>(this);
+
+            {
+              std::shared_lock<std::shared_mutex> scoped_lock(p_db.m_tmpl_mutex);
+              std::shared_lock<std::shared_mutex> scoped_lock2(p_db.m_update_mutex);
+              Configuration::shared_init_guard guard(p_db);
+
+              try
+                {
+                  self->p_generation = generation;
+                  self->init(false);
+                  return;
+                }
+              catch (Configuration::exclusive_lock_required&)
+                {
+                  TLOG_DEBUG(4) << "initialize object " << this << " by exclusive owner of template objects mutex";
+                }
+            }
+
+          std::lock_guard<std::shared_mutex> scoped_lock(p_db.m_tmpl_mutex);
+          self->p_generation = generation;
+          self->init(false);
         }
     }
 
@@ -439,7 +528,11 @@ template<class T>
       m_update_fn(DalObject::update<T>),
       m_unread_object_fn(DalObject::unread<T>),
       m_rename_object_fn(DalObject::change_id<T>),
+      m_memory_usage_fn(DalObject::memory_usage<T>),
+      m_rebind_objects_fn(DalObject::rebind_objects<T>),
       m_creator_fn(DalObject::create_instance<T>),
+      m_get_fn(DalObject::get_instance<T>),
+      m_find_fn(DalObject::find_instance<T>),
       m_algorithms(algorithms)
   {
     ;
@@ -471,15 +564,30 @@ template<class TARGET, class SOURCE>
   {
     if (s)
       {
-        std::lock_guard<std::mutex> scoped_lock(m_tmpl_mutex);
-        ConfigObjectImpl * obj = s->p_obj.m_impl;
+        ConfigObject& o = *const_cast<ConfigObject *>(&s->p_obj);
+
+        // the cache hit path takes shared lock; a new object is created by exclusive owner of the mutex
+        {
+          std::shared_lock<std::shared_mutex> scoped_lock(m_tmpl_mutex);
+          std::shared_lock<std::shared_mutex> scoped_lock2(m_update_mutex);  // the state of implementation object is checked
+          ConfigObjectImpl * obj = o.m_impl;
+
+          if (try_cast(&TARGET::s_class_name, obj) == false)
+            return nullptr;
 
-        if (try_cast(&TARGET::s_class_name, obj->m_class_name) == true)
           {
             std::lock_guard<std::mutex> scoped_lock(obj->m_mutex);
-            if (obj->m_state == dunedaq::conffwk::Valid)
-              return _get<TARGET>(*const_cast<ConfigObject *>(&s->p_obj), s->UID());
+            obj->check_generation();
+            if (obj->m_state != dunedaq::conffwk::Valid)
+              return nullptr;
           }
+
+          if (const TARGET * x = _find_cached<TARGET>(o, s->p_UID_ptr))
+            return x;
+        }
+
+        std::lock_guard<std::shared_mutex> scoped_lock(m_tmpl_mutex);
+        return _get<TARGET>(o, s->UID());
       }
 
     return nullptr;
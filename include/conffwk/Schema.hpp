@@ -8,7 +8,9 @@
 #ifndef CONFFWK_SCHEMA_H_
 #define CONFFWK_SCHEMA_H_
 
+#include <cstdint>
 #include <string>
+#include <variant>
 #include <vector>
 #include <iostream>
 
@@ -185,6 +187,63 @@ namespace dunedaq {
 
     };
 
+
+      /**
+       *  \brief The value of single-value or multi-value attribute.
+       *
+       *  The std::string type is used for string, enumeration, date, time and class attribute values, as for ConfigObject::get().
+       *  See ConfigObject::get_all().
+       */
+
+    typedef std::variant<
+      bool, uint8_t, int8_t, uint16_t, int16_t, uint32_t, int32_t, uint64_t, int64_t, float, double, std::string,
+      std::vector<bool>, std::vector<uint8_t>, std::vector<int8_t>, std::vector<uint16_t>, std::vector<int16_t>,
+      std::vector<uint32_t>, std::vector<int32_t>, std::vector<uint64_t>, std::vector<int64_t>,
+      std::vector<float>, std::vector<double>, std::vector<std::string>
+    > attribute_value_t;
+
+
+      /**
+       *  \brief The pre-resolved attribute of class.
+       *
+       *  The handle is made once per class and attribute by the Configuration::get_attribute_handle() method
+       *  and is used instead of the attribute name to read values of objects of this class or of its subclasses
+       *  (see ConfigObject::get()). A plugin may use the index to find the value without name lookup,
+       *  when the object is of the handle's class. The handle is valid until the database is unloaded.
+       */
+
+    struct AttributeHandle {
+
+      const std::string * p_class_name;    /*!< the name of class interned by the DalFactory */
+      const attribute_t * p_attribute;     /*!< the description of attribute */
+      std::size_t p_index;                 /*!< the index of attribute in class_t::p_attributes */
+
+        /** Name of attribute */
+
+      const std::string& name() const noexcept { return p_attribute->p_name; }
+
+    };
+
+
+      /**
+       *  \brief The pre-resolved relationship of class.
+       *
+       *  Same as AttributeHandle, but for relationship (see Configuration::get_relationship_handle()).
+       */
+
+    struct RelationshipHandle {
+
+      const std::string * p_class_name;         /*!< the name of class interned by the DalFactory */
+      const relationship_t * p_relationship;    /*!< the description of relationship */
+      std::size_t p_index;                      /*!< the index of relationship in class_t::p_relationships */
+
+        /** Name of relationship */
+
+      const std::string& name() const noexcept { return p_relationship->p_name; }
+
+    };
+
+
     const char * bool2str(bool value);
 
     std::ostream& operator<<(std::ostream& out, const attribute_t &);
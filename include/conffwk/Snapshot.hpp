@@ -0,0 +1,243 @@
+  /**
+   *  \file Snapshot.hpp This file contains ConfigurationSnapshot class,
+   *  that is a frozen read-only copy of configuration database.
+   *  \brief read-only configuration snapshot
+   */
+
+#ifndef CONFFWK_SNAPSHOT_H_
+#define CONFFWK_SNAPSHOT_H_
+
+#include <deque>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <variant>
+#include <vector>
+
+#include "conffwk/flat_map.hpp"
+#include "conffwk/map.hpp"
+#include "conffwk/set.hpp"
+#include "conffwk/Schema.hpp"
+
+namespace dunedaq {
+namespace conffwk {
+
+class Configuration;
+class ConfigObject;
+
+
+    /**
+     *  \brief Immutable read-only view of configuration.
+     *
+     *  The snapshot is created by the Configuration::snapshot() method. It contains copies of all database
+     *  objects (values of their attributes and relationships) and of the schema (descriptions of classes
+     *  and inheritance hierarchy) as they were at the moment of creation. The snapshot is not changed by
+     *  later database updates and does not refer to the Configuration object or its implementation.
+     *  All methods are const and do not lock any mutex, so the snapshot can be shared by any number of threads.
+     *
+     *  The values of attributes are stored after conversion by the configuration attribute converters
+     *  (see Configuration::register_converter()). The string type is used for values of string, enumeration,
+     *  date, time and class attributes, as for ConfigObject::get().
+     */
+
+class ConfigurationSnapshot
+{
+
+  friend class Configuration;
+
+public:
+
+    /// value of single-value or multi-value attribute
+
+  typedef conffwk::attribute_value_t value_t;
+
+  class object_t;
+
+
+private:
+
+    /// description of class and indices of its attributes, relationships and objects
+
+  struct class_info_t
+  {
+    std::unique_ptr<class_t> m_description;
+    conffwk::flat_map<std::string_view, std::size_t, string_view_hash, string_view_equal> m_attributes;         // name -> index in object_t::m_values
+    conffwk::flat_map<std::string_view, std::size_t, string_view_hash, string_view_equal> m_relationships;      // name -> index in object_t::m_refs
+    conffwk::flat_map<std::string_view, const object_t *, string_view_hash, string_view_equal> m_objects;       // object ID -> object of this class or of its subclass
+    std::vector<const class_info_t *> m_superclasses;                                                          // all superclasses
+  };
+
+
+public:
+
+    /**
+     *  \brief Object of snapshot.
+     *
+     *  The object provides access to values of attributes and relationships in style of ConfigObject.
+     *  The referenced objects belong to the same snapshot.
+     */
+
+  class object_t
+  {
+
+    friend class ConfigurationSnapshot;
+
+  public:
+
+      /// object ID
+
+    const std::string& UID() const noexcept { return m_id; }
+
+      /// object class name
+
+    const std::string& class_name() const noexcept { return m_class->m_description->p_name; }
+
+      /// name of database file containing the object
+
+    const std::string& contained_in() const noexcept { return *m_file; }
+
+
+      /**
+       *  \brief Get value of attribute.
+       *
+       *  The template parameter has to be the same as the one used to get the attribute value via ConfigObject::get().
+       *
+       *  \throw dunedaq::conffwk::Generic if there is no such attribute or it has different type
+       */
+
+    template<class T>
+      void
+      get(const std::string& name, T& value) const
+      {
+        if (const T * x = std::get_if<T>(&attribute(name)))
+          value = *x;
+        else
+          throw_bad_type(name);
+      }
+
+
+      /**
+       *  \brief Get value of single-value relationship.
+       *  \param name   name of relationship
+       *  \param value  referenced object or nullptr, if the value is not set
+       *  \throw dunedaq::conffwk::Generic if there is no such relationship
+       */
+
+    void get(const std::string& name, const object_t *& value) const;
+
+
+      /**
+       *  \brief Get values of multi-value relationship.
+       *  \throw dunedaq::conffwk::Generic if there is no such relationship
+       */
+
+    void get(const std::string& name, std::vector<const object_t *>& value) const;
+
+
+      /// return true, if the object is of given class or of its subclass
+
+    bool castable(const std::string& class_name) const noexcept;
+
+
+  private:
+
+    const value_t& attribute(const std::string& name) const;
+
+    [[noreturn]] void throw_bad_type(const std::string& name) const;
+
+    std::string m_id;
+    const class_info_t * m_class;
+    const std::string * m_file;
+    std::vector<value_t> m_values;                       // in order of class_t::p_attributes
+    std::vector<std::vector<const object_t *>> m_refs;   // in order of class_t::p_relationships
+  };
+
+
+public:
+
+  ~ConfigurationSnapshot() noexcept;
+
+  ConfigurationSnapshot(const ConfigurationSnapshot&) = delete;
+  ConfigurationSnapshot& operator=(const ConfigurationSnapshot&) = delete;
+
+
+    /**
+     *  \brief Get object by class name and ID.
+     *
+     *  Search object of given class or of its subclasses.
+     *
+     *  \return Return pointer to object or nullptr, if there is no such object.
+     */
+
+  const object_t * get(const std::string& class_name, const std::string& id) const noexcept;
+
+
+    /**
+     *  \brief Get all objects of class and of its subclasses.
+     *  \throw dunedaq::conffwk::Generic if there is no such class
+     */
+
+  void get(const std::string& class_name, std::vector<const object_t *>& objects) const;
+
+
+    /**
+     *  \brief Get description of class (including inherited attributes, relationships, superclasses and subclasses).
+     *  \throw dunedaq::conffwk::Generic if there is no such class
+     */
+
+  const class_t& get_class_info(const std::string& class_name) const;
+
+
+    /// return true, if the source class is the target class or its subclass
+
+  bool try_cast(const std::string& target, const std::string& source) const noexcept;
+
+
+    /// all superclasses of classes (the class names are interned by DalFactory as for Configuration::superclasses())
+
+  const conffwk::fmap<conffwk::fset>& superclasses() const noexcept { return p_superclasses; }
+
+
+    /// all subclasses of classes
+
+  const conffwk::fmap<conffwk::fset>& subclasses() const noexcept { return p_subclasses; }
+
+
+    /// number of objects
+
+  std::size_t size() const noexcept { return m_objects.size(); }
+
+
+private:
+
+  ConfigurationSnapshot() = default;
+
+    // the methods below are used by Configuration::snapshot() to fill the snapshot
+
+  void add_class(std::unique_ptr<class_t> description);
+
+  void add_object(ConfigObject& obj);
+
+  void link();
+
+  const class_info_t * find_class(std::string_view name) const noexcept;
+
+  std::deque<class_info_t> m_classes;
+  conffwk::flat_map<std::string_view, class_info_t *, string_view_hash, string_view_equal> m_classes_index;
+
+  std::deque<object_t> m_objects;
+  std::deque<std::string> m_files;
+  conffwk::flat_map<std::string_view, const std::string *, string_view_hash, string_view_equal> m_files_index;
+
+  conffwk::fmap<conffwk::fset> p_superclasses;
+  conffwk::fmap<conffwk::fset> p_subclasses;
+
+    // referenced objects are linked, when all objects are added
+
+  std::vector<std::pair<object_t *, std::vector<std::vector<ConfigObject>>>> m_unlinked;
+};
+
+} // namespace conffwk
+} // namespace dunedaq
+
+#endif // CONFFWK_SNAPSHOT_H_
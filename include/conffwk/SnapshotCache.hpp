@@ -0,0 +1,349 @@
+  /**
+   *  \file SnapshotCache.hpp This file contains SnapshotCacheImpl class,
+   *  that reads database from persistent binary snapshot file.
+   *  \brief binary snapshot cache of loaded database
+   */
+
+#ifndef CONFFWK_SNAPSHOTCACHE_H_
+#define CONFFWK_SNAPSHOTCACHE_H_
+
+#include <cstdint>
+#include <list>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+#include "conffwk/ConfigObjectImpl.hpp"
+#include "conffwk/ConfigurationImpl.hpp"
+#include "conffwk/flat_map.hpp"
+#include "conffwk/Schema.hpp"
+
+namespace dunedaq {
+namespace conffwk {
+
+class SnapshotCacheObject;
+
+
+    /**
+     *  \brief Configuration implementation reading database from binary snapshot file.
+     *
+     *  The snapshot file contains descriptions of classes, objects with values of their attributes and
+     *  relationships, included files and names, sizes and content hashes of all files of the database.
+     *  It is written by the Configuration after the database is loaded by implementation plug-in,
+     *  if the TDAQ_DB_SNAPSHOT_CACHE environment variable points to a directory. Later loads of the same
+     *  database use the snapshot instead of the plug-in, unless any database file was modified since;
+     *  then the snapshot is stale and it is rebuilt after the database is loaded by the plug-in.
+     *
+     *  The snapshot file is mapped into memory and only its index of objects is decoded on open;
+     *  the values of attributes and relationships of an object are decoded, when the object is read first time.
+     *
+     *  The implementation is read-only and does not support queries. To modify, subscribe or query the database,
+     *  the user replaces the snapshot by the implementation plug-in opening the same database before the configuration
+     *  is used by other threads (see Configuration::leave_snapshot_cache()); the template objects are re-bound to
+     *  the objects of the plug-in, and the snapshot is kept for ConfigObject handles on its objects until unload.
+     */
+
+class SnapshotCacheImpl : public ConfigurationImpl
+{
+
+  friend class SnapshotCacheObject;
+
+public:
+
+    /// name, size and content hash of database file used to detect stale snapshot
+
+  struct file_t
+  {
+    std::string p_name;
+    uint64_t p_size = 0;
+    uint64_t p_hash = 0;
+  };
+
+
+    /// object stored in snapshot
+
+  struct object_t
+  {
+    std::string p_id;
+    std::string p_class_name;
+    std::string p_file;
+    std::vector<attribute_value_t> p_values;                                   // in order of class_t::p_attributes
+    std::vector<std::vector<std::pair<std::string, std::string>>> p_refs;      // class names and IDs of referenced objects in order of class_t::p_relationships
+  };
+
+
+    /// contents of snapshot written by Configuration
+
+  struct contents_t
+  {
+    std::string p_db_name;
+    std::vector<file_t> p_files;
+    std::map<std::string, std::list<std::string>> p_includes;
+    std::vector<std::pair<std::unique_ptr<class_t>, std::unique_ptr<class_t>>> p_classes;   // descriptions with inherited properties and direct only
+    std::vector<object_t> p_objects;
+  };
+
+
+    /**
+     *  \brief Write snapshot file.
+     *
+     *  The file is written under temporary name and renamed, so concurrent readers never see partially written snapshot.
+     *
+     *  \throw dunedaq::conffwk::Generic in case of an error
+     */
+
+  static void write(const std::string& file_name, const contents_t& contents);
+
+
+    /**
+     *  \brief Open snapshot file.
+     *
+     *  \return Return implementation reading the snapshot or nullptr, if there is no such file,
+     *  the file cannot be read or the snapshot is stale.
+     */
+
+  static SnapshotCacheImpl * open(const std::string& file_name, const std::string& db_name) noexcept;
+
+
+    /// read size and content hash of file; return false, if the file cannot be read
+
+  static bool read_file_info(file_t& file) noexcept;
+
+
+  ~SnapshotCacheImpl() noexcept;
+
+
+    /// name of database stored in snapshot
+
+  const std::string& db_name() const noexcept { return m_db_name; }
+
+
+    // methods of ConfigurationImpl
+
+  void open_db(const std::string& db_name) override;
+  void close_db() override;
+  bool loaded() const noexcept override { return m_loaded; }
+  void create(const std::string& db_name, const std::list<std::string>& includes) override;
+  bool is_writable(const std::string& db_name) override;
+  void add_include(const std::string& db_name, const std::string& include) override;
+  void remove_include(const std::string& db_name, const std::string& include) override;
+  void get_includes(const std::string& db_name, std::list<std::string>& includes) const override;
+  void get_updated_dbs(std::list<std::string>& dbs) const override;
+  void set_commit_credentials(const std::string& user, const std::string& password) override;
+  void commit(const std::string& log_message) override;
+  void abort() override;
+  void prefetch_all_data() override;
+  std::vector<dunedaq::conffwk::Version> get_changes() override;
+  std::vector<dunedaq::conffwk::Version> get_versions(const std::string& since, const std::string& until, dunedaq::conffwk::Version::QueryType type, bool skip_irrelevant) override;
+  void get(const std::string& class_name, const std::string& id, ConfigObject& object, unsigned long rlevel, const std::vector<std::string> * rclasses) override;
+  void get(const std::string& class_name, std::vector<ConfigObject>& objects, const std::string& query, unsigned long rlevel, const std::vector<std::string> * rclasses) override;
+  void get(const ConfigObject& obj_from, const std::string& query, std::vector<ConfigObject>& objects, unsigned long rlevel, const std::vector<std::string> * rclasses) override;
+  bool test_object(const std::string& class_name, const std::string& id, unsigned long rlevel, const std::vector<std::string> * rclasses) override;
+  void create(const std::string& at, const std::string& class_name, const std::string& id, ConfigObject& object) override;
+  void create(const ConfigObject& at, const std::string& class_name, const std::string& id, ConfigObject& object) override;
+  void destroy(ConfigObject& object) override;
+  dunedaq::conffwk::class_t * get(const std::string& class_name, bool direct_only) override;
+  void get_superclasses(conffwk::fmap<conffwk::fset>& schema) override;
+  void subscribe(const std::set<std::string>& class_names, const std::map< std::string, std::set<std::string> >& objs, notify cb, pre_notify pre_cb) override;
+  void unsubscribe() override;
+  void print_profiling_info() noexcept override;
+
+
+private:
+
+  SnapshotCacheImpl(const std::string& file_name, const std::string& db_name, const char * data, std::size_t size) noexcept;
+
+  typedef conffwk::flat_map<std::string_view, uint32_t, string_view_hash, string_view_equal> index_t;
+
+    /// description of class and indices of its attributes, relationships and objects
+
+  struct class_info_t
+  {
+    std::unique_ptr<class_t> m_description;
+    std::unique_ptr<class_t> m_direct_description;
+    index_t m_attributes;                    // name -> index in class_t::p_attributes
+    index_t m_relationships;                 // name -> index in class_t::p_relationships
+    index_t m_objects;                       // ID -> index of object of this class (subclasses objects are not included)
+    std::vector<const class_info_t *> m_subclasses;
+  };
+
+    /// entry of objects index; the values are stored at given offset of the file
+
+  struct entry_t
+  {
+    std::string m_id;
+    const class_info_t * m_class;
+    uint32_t m_file;
+    uint64_t m_offset;
+  };
+
+    /// values of attributes and relationships of object decoded from the file
+
+  struct object_data_t
+  {
+    const entry_t * m_entry;
+    std::vector<attribute_value_t> m_values;                        // in order of class_t::p_attributes
+    std::vector<std::vector<uint32_t>> m_refs;                      // indices of referenced objects in order of class_t::p_relationships
+    std::vector<std::pair<uint32_t, uint32_t>> m_referenced_by;     // indices of objects referencing this one and of their relationships
+  };
+
+  void read_index();
+
+  void decode(uint32_t idx, object_data_t& data) const;
+
+  const class_info_t * find_class(const std::string& name) const noexcept;
+
+  const entry_t * find_object(const std::string& class_name, const std::string& id) const noexcept;
+
+  [[noreturn]] void throw_read_only(const char * action) const;
+
+    /// get cached implementation object or create it; the object is created under m_objects_mutex
+
+  void get_object(uint32_t idx, ConfigObject& object);
+
+  std::string m_file_name;
+  std::string m_db_name;
+  const char * m_data;
+  std::size_t m_size;
+  bool m_loaded;
+
+  std::vector<std::string> m_files;
+  std::map<std::string, std::list<std::string>> m_includes;
+  std::vector<std::unique_ptr<class_info_t>> m_classes;
+  conffwk::flat_map<std::string_view, const class_info_t *, string_view_hash, string_view_equal> m_classes_index;
+  std::vector<entry_t> m_objects;
+  std::mutex m_objects_mutex;
+
+  unsigned long p_number_of_decoded_objects;
+};
+
+
+    /**
+     *  \brief Object of database snapshot.
+     *
+     *  The values of attributes and relationships are decoded from the snapshot file, before the object is created.
+     */
+
+class SnapshotCacheObject : public ConfigObjectImpl
+{
+
+  friend class SnapshotCacheImpl;
+
+public:
+
+  SnapshotCacheObject(SnapshotCacheImpl::object_data_t& data, ConfigurationImpl * impl) noexcept;
+
+  void set(SnapshotCacheImpl::object_data_t& data) noexcept;
+
+  const std::string contained_in() const override;
+
+  using ConfigObjectImpl::get;  // the methods reading values using handles fall back to the ones below
+
+  void get(const std::string& name, bool& value) override                                { get_value(name, value); }
+  void get(const std::string& name, uint8_t& value) override                             { get_value(name, value); }
+  void get(const std::string& name, int8_t& value) override                              { get_value(name, value); }
+  void get(const std::string& name, uint16_t& value) override                            { get_value(name, value); }
+  void get(const std::string& name, int16_t& value) override                             { get_value(name, value); }
+  void get(const std::string& name, uint32_t& value) override                            { get_value(name, value); }
+  void get(const std::string& name, int32_t& value) override                             { get_value(name, value); }
+  void get(const std::string& name, uint64_t& value) override                            { get_value(name, value); }
+  void get(const std::string& name, int64_t& value) override                             { get_value(name, value); }
+  void get(const std::string& name, float& value) override                               { get_value(name, value); }
+  void get(const std::string& name, double& value) override                              { get_value(name, value); }
+  void get(const std::string& name, std::string& value) override                         { get_value(name, value); }
+  void get(const std::string& name, ConfigObject& value) override;
+
+  void get(const std::string& name, std::vector<bool>& value) override                   { get_value(name, value); }
+  void get(const std::string& name, std::vector<uint8_t>& value) override                { get_value(name, value); }
+  void get(const std::string& name, std::vector<int8_t>& value) override                 { get_value(name, value); }
+  void get(const std::string& name, std::vector<uint16_t>& value) override               { get_value(name, value); }
+  void get(const std::string& name, std::vector<int16_t>& value) override                { get_value(name, value); }
+  void get(const std::string& name, std::vector<uint32_t>& value) override               { get_value(name, value); }
+  void get(const std::string& name, std::vector<int32_t>& value) override                { get_value(name, value); }
+  void get(const std::string& name, std::vector<uint64_t>& value) override               { get_value(name, value); }
+  void get(const std::string& name, std::vector<int64_t>& value) override                { get_value(name, value); }
+  void get(const std::string& name, std::vector<float>& value) override                  { get_value(name, value); }
+  void get(const std::string& name, std::vector<double>& value) override                 { get_value(name, value); }
+  void get(const std::string& name, std::vector<std::string>& value) override            { get_value(name, value); }
+  void get(const std::string& name, std::vector<ConfigObject>& value) override;
+
+  void get_batch(const class_t& description, std::vector<attribute_value_t>& values) override;
+
+  bool rel(const std::string& name, std::vector<ConfigObject>& value) override;
+  void referenced_by(std::vector<ConfigObject>& value, const std::string& association, bool check_composite_only, unsigned long rlevel, const std::vector<std::string> * rclasses) const override;
+
+  void set(const std::string& name, bool) override                                       { throw_read_only(name); }
+  void set(const std::string& name, uint8_t) override                                    { throw_read_only(name); }
+  void set(const std::string& name, int8_t) override                                     { throw_read_only(name); }
+  void set(const std::string& name, uint16_t) override                                   { throw_read_only(name); }
+  void set(const std::string& name, int16_t) override                                    { throw_read_only(name); }
+  void set(const std::string& name, uint32_t) override                                   { throw_read_only(name); }
+  void set(const std::string& name, int32_t) override                                    { throw_read_only(name); }
+  void set(const std::string& name, uint64_t) override                                   { throw_read_only(name); }
+  void set(const std::string& name, int64_t) override                                    { throw_read_only(name); }
+  void set(const std::string& name, float) override                                      { throw_read_only(name); }
+  void set(const std::string& name, double) override                                     { throw_read_only(name); }
+  void set(const std::string& name, const std::string&) override                         { throw_read_only(name); }
+  void set_enum(const std::string& name, const std::string&) override                    { throw_read_only(name); }
+  void set_class(const std::string& name, const std::string&) override                   { throw_read_only(name); }
+  void set_date(const std::string& name, const std::string&) override                    { throw_read_only(name); }
+  void set_time(const std::string& name, const std::string&) override                    { throw_read_only(name); }
+
+  void set(const std::string& name, const std::vector<bool>&) override                   { throw_read_only(name); }
+  void set(const std::string& name, const std::vector<uint8_t>&) override                { throw_read_only(name); }
+  void set(const std::string& name, const std::vector<int8_t>&) override                 { throw_read_only(name); }
+  void set(const std::string& name, const std::vector<uint16_t>&) override               { throw_read_only(name); }
+  void set(const std::string& name, const std::vector<int16_t>&) override                { throw_read_only(name); }
+  void set(const std::string& name, const std::vector<uint32_t>&) override               { throw_read_only(name); }
+  void set(const std::string& name, const std::vector<int32_t>&) override                { throw_read_only(name); }
+  void set(const std::string& name, const std::vector<uint64_t>&) override               { throw_read_only(name); }
+  void set(const std::string& name, const std::vector<int64_t>&) override                { throw_read_only(name); }
+  void set(const std::string& name, const std::vector<float>&) override                  { throw_read_only(name); }
+  void set(const std::string& name, const std::vector<double>&) override                 { throw_read_only(name); }
+  void set(const std::string& name, const std::vector<std::string>&) override            { throw_read_only(name); }
+  void set_enum(const std::string& name, const std::vector<std::string>&) override       { throw_read_only(name); }
+  void set_class(const std::string& name, const std::vector<std::string>&) override      { throw_read_only(name); }
+  void set_date(const std::string& name, const std::vector<std::string>&) override       { throw_read_only(name); }
+  void set_time(const std::string& name, const std::vector<std::string>&) override       { throw_read_only(name); }
+
+  void set(const std::string& name, const ConfigObject *, bool) override                 { throw_read_only(name); }
+  void set(const std::string& name, const std::vector<const ConfigObject*>&, bool) override { throw_read_only(name); }
+
+  void move(const std::string& at) override;
+  void rename(const std::string& new_id) override;
+  void reset() override;
+
+
+private:
+
+  template<class T>
+    void
+    get_value(const std::string& name, T& value)
+    {
+      if (const T * x = std::get_if<T>(&attribute(name)))
+        value = *x;
+      else
+        throw_bad_type(name);
+    }
+
+  const attribute_value_t& attribute(const std::string& name) const;
+
+  std::size_t relationship(const std::string& name) const;
+
+  [[noreturn]] void throw_bad_type(const std::string& name) const;
+
+  [[noreturn]] void throw_read_only(const std::string& name) const;
+
+  SnapshotCacheImpl& impl() const noexcept { return *static_cast<SnapshotCacheImpl *>(m_impl); }
+
+  SnapshotCacheImpl::object_data_t m_data;
+};
+
+} // namespace conffwk
+} // namespace dunedaq
+
+#endif // CONFFWK_SNAPSHOTCACHE_H_
@@ -0,0 +1,449 @@
+#ifndef CONFFWK_FLAT_MAP_H_
+#define CONFFWK_FLAT_MAP_H_
+
+#include <cstddef>
+#include <functional>
+#include <iterator>
+#include <memory>
+#include <new>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <tuple>
+#include <utility>
+
+namespace dunedaq {
+namespace conffwk
+{
+    // transparent hash and equality of strings: allow lookup by std::string_view or C string without std::string temporary
+
+  struct string_view_hash
+  {
+    inline size_t operator() ( std::string_view x ) const noexcept {
+      return std::hash<std::string_view>()(x);
+    }
+  };
+
+  struct string_view_equal
+  {
+    inline bool operator() ( std::string_view x, std::string_view y ) const noexcept {
+      return x == y;
+    }
+  };
+
+
+    /**
+     *  \brief Hash map with open addressing.
+     *
+     *  The elements are stored in a single array probed linearly, so a lookup
+     *  does not allocate memory and touches few cache lines. The lookup and erase
+     *  methods are templates accepting any key type supported by the Hash and
+     *  KeyEqual functors (e.g. std::string_view for maps keyed by std::string).
+     *
+     *  Unlike std::unordered_map, an insertion may invalidate references and iterators
+     *  (when the array grows); an erase invalidates only the erased element.
+     */
+
+  template<class Key, class T, class Hash = std::hash<Key>, class KeyEqual = std::equal_to<Key>>
+    class flat_map
+    {
+
+    public:
+
+      typedef Key key_type;
+      typedef T mapped_type;
+      typedef std::pair<Key, T> value_type;
+      typedef std::size_t size_type;
+
+
+      template<class M, class V>
+        class basic_iterator
+        {
+          friend class flat_map;
+
+        public:
+
+          typedef std::forward_iterator_tag iterator_category;
+          typedef typename flat_map::value_type value_type;
+          typedef std::ptrdiff_t difference_type;
+          typedef V* pointer;
+          typedef V& reference;
+
+          basic_iterator() noexcept : m_map(nullptr), m_idx(0) { ; }
+
+            // allow conversion of iterator to const_iterator
+          template<class M2, class V2>
+            basic_iterator(const basic_iterator<M2, V2>& x) noexcept : m_map(x.m_map), m_idx(x.m_idx) { ; }
+
+          reference operator*() const noexcept { return m_map->m_slots[m_idx]; }
+          pointer operator->() const noexcept { return m_map->m_slots + m_idx; }
+
+          basic_iterator& operator++() noexcept { m_idx = m_map->next(m_idx + 1); return *this; }
+          basic_iterator operator++(int) noexcept { basic_iterator x(*this); ++(*this); return x; }
+
+          bool operator==(const basic_iterator& x) const noexcept { return m_idx == x.m_idx; }
+          bool operator!=(const basic_iterator& x) const noexcept { return m_idx != x.m_idx; }
+
+        private:
+
+          template<class M2, class V2> friend class basic_iterator;
+
+          basic_iterator(M * map, size_type idx) noexcept : m_map(map), m_idx(idx) { ; }
+
+          M * m_map;
+          size_type m_idx;
+        };
+
+      typedef basic_iterator<flat_map, value_type> iterator;
+      typedef basic_iterator<const flat_map, const value_type> const_iterator;
+
+
+      flat_map() noexcept :
+        m_slots(nullptr), m_ctrl(nullptr), m_capacity(0), m_size(0), m_deleted(0)
+      {
+        ;
+      }
+
+      flat_map(const flat_map& x) : flat_map()
+      {
+        reserve(x.m_size);
+        for (const auto& i : x)
+          try_emplace(i.first, i.second);
+      }
+
+      flat_map(flat_map&& x) noexcept : flat_map()
+      {
+        swap(x);
+      }
+
+      flat_map&
+      operator=(const flat_map& x)
+      {
+        if (this != &x)
+          {
+            flat_map tmp(x);
+            swap(tmp);
+          }
+        return *this;
+      }
+
+      flat_map&
+      operator=(flat_map&& x) noexcept
+      {
+        swap(x);
+        return *this;
+      }
+
+      ~flat_map() noexcept
+      {
+        release();
+      }
+
+      void
+      swap(flat_map& x) noexcept
+      {
+        std::swap(m_slots, x.m_slots);
+        std::swap(m_ctrl, x.m_ctrl);
+        std::swap(m_capacity, x.m_capacity);
+        std::swap(m_size, x.m_size);
+        std::swap(m_deleted, x.m_deleted);
+      }
+
+
+      iterator begin() noexcept { return iterator(this, next(0)); }
+      iterator end() noexcept { return iterator(this, m_capacity); }
+      const_iterator begin() const noexcept { return const_iterator(this, next(0)); }
+      const_iterator end() const noexcept { return const_iterator(this, m_capacity); }
+      const_iterator cbegin() const noexcept { return begin(); }
+      const_iterator cend() const noexcept { return end(); }
+
+      bool empty() const noexcept { return (m_size == 0); }
+      size_type size() const noexcept { return m_size; }
+
+        /// number of allocated slots
+
+      size_type capacity() const noexcept { return m_capacity; }
+
+
+      void
+      clear() noexcept
+      {
+        release();
+      }
+
+
+        /// make space for given number of elements without growing
+
+      void
+      reserve(size_type num)
+      {
+        size_type capacity = 8;
+
+        while (capacity * 3 < num * 4)
+          capacity *= 2;
+
+        if (capacity > m_capacity)
+          rehash(capacity);
+      }
+
+
+      template<class K>
+        iterator
+        find(const K& key) noexcept
+        {
+          return iterator(this, find_index(key));
+        }
+
+      template<class K>
+        const_iterator
+        find(const K& key) const noexcept
+        {
+          return const_iterator(this, find_index(key));
+        }
+
+      template<class K>
+        size_type
+        count(const K& key) const noexcept
+        {
+          return (find_index(key) != m_capacity ? 1 : 0);
+        }
+
+
+        /**
+         *  Insert element constructed from the arguments, if there is no element with such key.
+         *  Return iterator on the element with given key and true, if the element was inserted.
+         */
+
+      template<class K, class... Args>
+        std::pair<iterator, bool>
+        try_emplace(K&& key, Args&&... args)
+        {
+          size_type free = m_capacity;
+
+          if (m_capacity)
+            {
+              const size_type mask = m_capacity - 1;
+
+              for (size_type i = home(key);; i = (i + 1) & mask)
+                {
+                  if (m_ctrl[i] == s_empty)
+                    {
+                      if (free == m_capacity)
+                        free = i;
+                      break;
+                    }
+                  else if (m_ctrl[i] == s_deleted)
+                    {
+                      if (free == m_capacity)
+                        free = i;
+                    }
+                  else if (KeyEqual()(m_slots[i].first, key))
+                    {
+                      return std::make_pair(iterator(this, i), false);
+                    }
+                }
+            }
+
+            // grow (or only remove deleted slots) and find free slot again
+
+          if (m_capacity == 0 || (m_size + m_deleted + 1) * 4 > m_capacity * 3)
+            {
+              rehash(m_capacity == 0 ? 8 : ((m_size + 1) * 2 > m_capacity ? m_capacity * 2 : m_capacity));
+
+              free = home(key);
+
+              while (m_ctrl[free] != s_empty)
+                free = (free + 1) & (m_capacity - 1);
+            }
+
+          ::new (static_cast<void*>(m_slots + free)) value_type(std::piecewise_construct, std::forward_as_tuple(Key(std::forward<K>(key))), std::forward_as_tuple(std::forward<Args>(args)...));
+
+          if (m_ctrl[free] == s_deleted)
+            m_deleted--;
+
+          m_ctrl[free] = s_full;
+          m_size++;
+
+          return std::make_pair(iterator(this, free), true);
+        }
+
+      template<class K, class V>
+        std::pair<iterator, bool>
+        emplace(K&& key, V&& value)
+        {
+          return try_emplace(std::forward<K>(key), std::forward<V>(value));
+        }
+
+      std::pair<iterator, bool>
+      insert(const value_type& x)
+      {
+        return try_emplace(x.first, x.second);
+      }
+
+      template<class K>
+        T&
+        operator[](K&& key)
+        {
+          return try_emplace(std::forward<K>(key)).first->second;
+        }
+
+      template<class K>
+        T&
+        at(const K& key)
+        {
+          size_type i = find_index(key);
+
+          if (i == m_capacity)
+            throw std::out_of_range("conffwk::flat_map::at()");
+
+          return m_slots[i].second;
+        }
+
+
+        /// remove element; return iterator on the next element
+
+      iterator
+      erase(const_iterator pos) noexcept
+      {
+        destroy(pos.m_idx);
+        return iterator(this, next(pos.m_idx + 1));
+      }
+
+      iterator
+      erase(iterator pos) noexcept
+      {
+        return erase(const_iterator(pos));
+      }
+
+      template<class K>
+        size_type
+        erase(const K& key) noexcept
+        {
+          size_type i = find_index(key);
+
+          if (i == m_capacity)
+            return 0;
+
+          destroy(i);
+          return 1;
+        }
+
+
+    private:
+
+      enum : unsigned char { s_empty = 0, s_full = 1, s_deleted = 2 };
+
+      template<class K>
+        size_type
+        home(const K& key) const noexcept
+        {
+          // mix bits, since hashes of pointers or small integers have poor low bits
+          size_t h = Hash()(key);
+          h ^= h >> 33;
+          h *= 0xff51afd7ed558ccdULL;
+          h ^= h >> 33;
+          return h & (m_capacity - 1);
+        }
+
+      template<class K>
+        size_type
+        find_index(const K& key) const noexcept
+        {
+          if (m_size == 0)
+            return m_capacity;
+
+          const size_type mask = m_capacity - 1;
+
+          for (size_type i = home(key);; i = (i + 1) & mask)
+            {
+              if (m_ctrl[i] == s_empty)
+                return m_capacity;
+              else if (m_ctrl[i] == s_full && KeyEqual()(m_slots[i].first, key))
+                return i;
+            }
+        }
+
+      size_type
+      next(size_type idx) const noexcept
+      {
+        while (idx < m_capacity && m_ctrl[idx] != s_full)
+          ++idx;
+
+        return idx;
+      }
+
+      void
+      destroy(size_type idx) noexcept
+      {
+        m_slots[idx].~value_type();
+        m_ctrl[idx] = s_deleted;
+        m_size--;
+        m_deleted++;
+      }
+
+      void
+      rehash(size_type capacity)
+      {
+        std::allocator<value_type> a;
+
+        value_type * slots = a.allocate(capacity);
+        unsigned char * ctrl = new unsigned char[capacity]();
+
+        const size_type mask = capacity - 1;
+
+        std::swap(slots, m_slots);
+        std::swap(ctrl, m_ctrl);
+        std::swap(capacity, m_capacity);
+
+        // move elements from old array
+        for (size_type i = 0; i < capacity; ++i)
+          if (ctrl[i] == s_full)
+            {
+              size_type j = home(slots[i].first);
+
+              while (m_ctrl[j] != s_empty)
+                j = (j + 1) & mask;
+
+              ::new (static_cast<void*>(m_slots + j)) value_type(std::move(slots[i]));
+              m_ctrl[j] = s_full;
+              slots[i].~value_type();
+            }
+
+        m_deleted = 0;
+
+        if (slots)
+          {
+            a.deallocate(slots, capacity);
+            delete[] ctrl;
+          }
+      }
+
+      void
+      release() noexcept
+      {
+        if (m_slots)
+          {
+            for (size_type i = 0; i < m_capacity; ++i)
+              if (m_ctrl[i] == s_full)
+                m_slots[i].~value_type();
+
+            std::allocator<value_type>().deallocate(m_slots, m_capacity);
+            delete[] m_ctrl;
+          }
+
+        m_slots = nullptr;
+        m_ctrl = nullptr;
+        m_capacity = m_size = m_deleted = 0;
+      }
+
+      value_type * m_slots;
+      unsigned char * m_ctrl;
+      size_type m_capacity;
+      size_type m_size;
+      size_type m_deleted;
+    };
+
+} // namespace conffwk
+} // namespace dunedaq
+
+#endif // CONFFWK_FLAT_MAP_H_
@@ -2,6 +2,7 @@
 #define CONFFWK_MAP_H_
 
 #include "conffwk/string_ptr.hpp"
+#include <map>
 #include <unordered_map>
 
 namespace dunedaq {
@@ -48,6 +49,17 @@ namespace conffwk
         ;
       }
     };
+
+  // compare string pointers (not values!)
+  template<class T>
+    class fmultimap : public std::unordered_multimap<const std::string *, T, string_ptr_hash>
+    {
+    public:
+      fmultimap()
+      {
+        ;
+      }
+    };
 } // namespace conffwk
 } // namespace dunedaq
 
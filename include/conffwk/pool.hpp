@@ -0,0 +1,183 @@
+#ifndef CONFFWK_POOL_H_
+#define CONFFWK_POOL_H_
+
+#include <algorithm>
+#include <cstddef>
+#include <new>
+#include <vector>
+
+namespace dunedaq {
+namespace conffwk
+{
+    /**
+     *  \brief Memory pool of fixed-size blocks.
+     *
+     *  Blocks are carved out of large chunks, so objects of the same type are
+     *  packed contiguously and are released by a few bulk frees when the pool
+     *  is cleared or destroyed. The pool does not call destructors of objects;
+     *  the owner of the pool has to destroy them explicitly before the release.
+     *  A deallocated block is reused by next allocation.
+     *
+     *  The pool is not thread-safe.
+     */
+
+  class pool
+  {
+
+  public:
+
+    explicit pool(std::size_t size) noexcept :
+      m_block_size(align(size < sizeof(free_block) ? sizeof(free_block) : size)),
+      m_next(nullptr),
+      m_end(nullptr),
+      m_free(nullptr),
+      m_count(0)
+    {
+      ;
+    }
+
+    ~pool() noexcept
+    {
+      clear();
+    }
+
+    pool(const pool&) = delete;
+    pool& operator=(const pool&) = delete;
+
+
+      /// allocate memory block; throw std::bad_alloc in case of failure
+
+    void *
+    allocate()
+    {
+      m_count++;
+
+      if (m_free)
+        {
+          void * p = m_free;
+          m_free = m_free->m_next;
+          return p;
+        }
+
+      if (m_next == m_end)
+        {
+            // the chunks grow from 32 up to 1024 blocks
+
+          std::size_t len = (s_min_chunk_blocks << (m_chunks.size() < 5 ? m_chunks.size() : 5)) * m_block_size;
+          chunk c { static_cast<char *>(::operator new(len)), len };
+          m_chunks.insert(std::upper_bound(m_chunks.begin(), m_chunks.end(), c), c);
+          m_next = c.m_data;
+          m_end = c.m_data + len;
+        }
+
+      void * p = m_next;
+      m_next += m_block_size;
+      return p;
+    }
+
+
+      /// return memory block to the pool
+
+    void
+    deallocate(void * p) noexcept
+    {
+      free_block * b = static_cast<free_block *>(p);
+      b->m_next = m_free;
+      m_free = b;
+      m_count--;
+    }
+
+
+      /// check if the memory block belongs to the pool
+
+    bool
+    contains(const void * p) const noexcept
+    {
+      const chunk c { const_cast<char *>(static_cast<const char *>(p)), 0 };
+      auto i = std::upper_bound(m_chunks.begin(), m_chunks.end(), c);
+      return (i != m_chunks.begin() && c.m_data < (i - 1)->m_data + (i - 1)->m_size);
+    }
+
+
+      /// release all memory at once
+
+    void
+    clear() noexcept
+    {
+      for (auto& x : m_chunks)
+        ::operator delete(x.m_data);
+
+      m_chunks.clear();
+      m_next = m_end = nullptr;
+      m_free = nullptr;
+      m_count = 0;
+    }
+
+
+      /// size of single block in bytes
+
+    std::size_t
+    block_size() const noexcept
+    {
+      return m_block_size;
+    }
+
+
+      /// number of allocated blocks
+
+    std::size_t
+    size() const noexcept
+    {
+      return m_count;
+    }
+
+
+      /// size of memory held by the pool in bytes
+
+    std::size_t
+    capacity() const noexcept
+    {
+      std::size_t len = 0;
+
+      for (const auto& x : m_chunks)
+        len += x.m_size;
+
+      return len;
+    }
+
+
+  private:
+
+    struct free_block
+    {
+      free_block * m_next;
+    };
+
+    struct chunk
+    {
+      char * m_data;
+      std::size_t m_size;
+
+      bool operator<(const chunk& x) const noexcept { return m_data < x.m_data; }
+    };
+
+    static constexpr std::size_t s_min_chunk_blocks = 32;
+
+    static std::size_t
+    align(std::size_t size) noexcept
+    {
+      return (size + alignof(std::max_align_t) - 1) / alignof(std::max_align_t) * alignof(std::max_align_t);
+    }
+
+    const std::size_t m_block_size;
+    std::vector<chunk> m_chunks; // sorted by address
+    char * m_next;
+    char * m_end;
+    free_block * m_free;
+    std::size_t m_count;
+  };
+
+} // namespace conffwk
+} // namespace dunedaq
+
+#endif // CONFFWK_POOL_H_
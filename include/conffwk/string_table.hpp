@@ -0,0 +1,281 @@
+#ifndef CONFFWK_STRING_TABLE_H_
+#define CONFFWK_STRING_TABLE_H_
+
+#include <array>
+#include <atomic>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "conffwk/flat_map.hpp"
+
+namespace dunedaq {
+namespace conffwk
+{
+    /**
+     *  \brief Table of interned strings.
+     *
+     *  Each string is stored once; the address of the stored string is used as
+     *  compact handle, which can be compared and hashed as a pointer (see fmap and fset).
+     *  The handles are valid until the table is cleared or destroyed.
+     *
+     *  The table is thread-safe. It is split into stripes selected by hash of string,
+     *  each protected by own mutex, so concurrent lookups of different strings rarely contend.
+     */
+
+  class string_table
+  {
+
+  public:
+
+    string_table() = default;
+
+    string_table(const string_table&) = delete;
+    string_table& operator=(const string_table&) = delete;
+
+
+      /// get interned string; insert it, if the table does not have such string yet
+
+    const std::string&
+    intern(std::string_view s)
+    {
+      stripe& x(get_stripe(s));
+
+      std::lock_guard<std::mutex> scoped_lock(x.m_mutex);
+
+      auto i = x.m_index.find(s);
+
+      if (i != x.m_index.end())
+        return *i->second;
+
+      const std::string& str = x.m_strings.emplace_back(s);
+      x.m_index.try_emplace(std::string_view(str), &str);
+      return str;
+    }
+
+
+      /// get interned string; return nullptr, if the table does not have such string
+
+    const std::string *
+    find(std::string_view s) const noexcept
+    {
+      const stripe& x(get_stripe(s));
+
+      std::lock_guard<std::mutex> scoped_lock(x.m_mutex);
+      auto i = x.m_index.find(s);
+      return (i != x.m_index.end() ? i->second : nullptr);
+    }
+
+
+      /// remove all strings; the caller has to guarantee that their handles are not used anymore
+
+    void
+    clear() noexcept
+    {
+      for (auto& x : m_stripes)
+        {
+          std::lock_guard<std::mutex> scoped_lock(x.m_mutex);
+          x.m_index.clear();
+          x.m_strings.clear();
+        }
+    }
+
+
+      /// exchange strings with other table; the strings are not moved, so their handles remain valid
+
+    void
+    swap(string_table& other) noexcept
+    {
+      for (std::size_t i = 0; i < s_num_of_stripes; ++i)
+        {
+          std::scoped_lock scoped_lock(m_stripes[i].m_mutex, other.m_stripes[i].m_mutex);
+          m_stripes[i].m_strings.swap(other.m_stripes[i].m_strings);
+          m_stripes[i].m_index.swap(other.m_stripes[i].m_index);
+        }
+    }
+
+
+      /// number of interned strings
+
+    std::size_t
+    size() const noexcept
+    {
+      std::size_t num = 0;
+
+      for (const auto& x : m_stripes)
+        {
+          std::lock_guard<std::mutex> scoped_lock(x.m_mutex);
+          num += x.m_index.size();
+        }
+
+      return num;
+    }
+
+
+  private:
+
+    struct stripe
+    {
+      mutable std::mutex m_mutex;
+      std::deque<std::string> m_strings;  // the deque never moves stored strings
+      conffwk::flat_map<std::string_view, const std::string *, string_view_hash, string_view_equal> m_index;
+    };
+
+    static constexpr std::size_t s_num_of_stripes = 16;
+
+    stripe&
+    get_stripe(std::string_view s) noexcept
+    {
+      return m_stripes[string_view_hash()(s) % s_num_of_stripes];
+    }
+
+    const stripe&
+    get_stripe(std::string_view s) const noexcept
+    {
+      return m_stripes[string_view_hash()(s) % s_num_of_stripes];
+    }
+
+    std::array<stripe, s_num_of_stripes> m_stripes;
+  };
+
+
+    /**
+     *  \brief Table of interned strings optimised for lookups of existing strings.
+     *
+     *  The handles have the same properties as ones of the string_table. The table is thread-safe.
+     *  The lookup of interned string does not lock any mutex: the index is an open-addressing hash
+     *  table of atomic pointers, which are only set once. A new string is inserted under mutex;
+     *  when the index becomes half full, it is copied into a twice bigger one, which replaces it.
+     *  The replaced indices are kept until the table is destroyed, since they can be still read
+     *  by concurrent lookups (their total size is less than the size of the current index).
+     *
+     *  The table is intended for small sets of strings, which are rarely changed (e.g. class names).
+     */
+
+  class read_mostly_string_table
+  {
+
+  public:
+
+    read_mostly_string_table()
+    {
+      m_indices.push_back(std::make_unique<index>(s_initial_capacity));
+      m_index = m_indices.back().get();
+    }
+
+    read_mostly_string_table(const read_mostly_string_table&) = delete;
+    read_mostly_string_table& operator=(const read_mostly_string_table&) = delete;
+
+
+      /// get interned string; insert it, if the table does not have such string yet (the mutex is only locked in such case)
+
+    const std::string&
+    intern(std::string_view s)
+    {
+      if (const std::string * x = find(s))
+        return *x;
+
+      std::lock_guard<std::mutex> scoped_lock(m_mutex);
+
+      // another thread may insert the string after above lookup
+      if (const std::string * x = find(s))
+        return *x;
+
+      const std::string& str = m_strings.emplace_back(s);
+
+      index * x = m_indices.back().get();
+
+      if (2 * m_strings.size() > x->m_capacity)
+        {
+          m_indices.push_back(std::make_unique<index>(x->m_capacity * 2));
+
+          for (const auto& i : m_strings)
+            if (&i != &str)
+              m_indices.back()->insert(&i);
+
+          x = m_indices.back().get();
+          x->insert(&str);
+          m_index.store(x, std::memory_order_release);
+        }
+      else
+        {
+          x->insert(&str);
+        }
+
+      return str;
+    }
+
+
+      /// get interned string; return nullptr, if the table does not have such string (never locks)
+
+    const std::string *
+    find(std::string_view s) const noexcept
+    {
+      const index * x = m_index.load(std::memory_order_acquire);
+      const std::size_t mask = x->m_capacity - 1;
+
+      for (std::size_t i = string_view_hash()(s) & mask;; i = (i + 1) & mask)
+        {
+          const std::string * str = x->m_slots[i].load(std::memory_order_acquire);
+
+          if (str == nullptr)
+            return nullptr;
+
+          if (*str == s)
+            return str;
+        }
+    }
+
+
+      /// number of interned strings
+
+    std::size_t
+    size() const noexcept
+    {
+      std::lock_guard<std::mutex> scoped_lock(m_mutex);
+      return m_strings.size();
+    }
+
+
+  private:
+
+    struct index
+    {
+      explicit index(std::size_t capacity) :
+        m_capacity(capacity),
+        m_slots(new std::atomic<const std::string *>[capacity]())
+      {
+      }
+
+      // called under the mutex; the capacity is always greater than the number of strings
+      void
+      insert(const std::string * str) noexcept
+      {
+        const std::size_t mask = m_capacity - 1;
+        std::size_t i = string_view_hash()(*str) & mask;
+
+        while (m_slots[i].load(std::memory_order_relaxed) != nullptr)
+          i = (i + 1) & mask;
+
+        m_slots[i].store(str, std::memory_order_release);
+      }
+
+      const std::size_t m_capacity;  // power of 2
+      std::unique_ptr<std::atomic<const std::string *>[]> m_slots;
+    };
+
+    static constexpr std::size_t s_initial_capacity = 256;
+
+    mutable std::mutex m_mutex;                    // protects insertion of new strings
+    std::deque<std::string> m_strings;             // the deque never moves stored strings
+    std::vector<std::unique_ptr<index>> m_indices; // current index is the last one
+    std::atomic<const index *> m_index;
+  };
+
+} // namespace conffwk
+} // namespace dunedaq
+
+#endif // CONFFWK_STRING_TABLE_H_
@@ -15,24 +15,47 @@ ConfigObject::ConfigObject() noexcept :
 {
 }
 
+void
+ConfigObject::add_ref(ConfigObjectImpl * impl) noexcept
+{
+  if(impl) {
+    impl->m_refs.fetch_add(1, std::memory_order_relaxed);
+  }
+}
+
+void
+ConfigObject::release_ref(ConfigObjectImpl * impl) noexcept
+{
+  // destroy an object of unloaded implementation (see ConfigurationImpl::clean()) with the last handle;
+  // otherwise do not touch the object after the release, since another thread can evict it
+  if(impl && impl->m_refs.fetch_sub(1, std::memory_order_acq_rel) == (ConfigObjectImpl::s_orphan | 1)) {
+    ConfigObjectImpl::destroy_orphan(impl);
+  }
+}
+
 ConfigObject::ConfigObject(const ConfigObject& other) noexcept :
   m_impl(other.m_impl)
 {
+  add_ref(m_impl);
 }
 
 ConfigObject::ConfigObject(ConfigObjectImpl *impl) noexcept :
   m_impl(impl)
 {
+  add_ref(m_impl);
 }
 
 ConfigObject::~ConfigObject() noexcept
 {
+  release_ref(m_impl);
 }
 
 ConfigObject&
 ConfigObject::operator=(const ConfigObject& other) noexcept
 {
-  if(this != &other) {
+  if(this != &other && m_impl != other.m_impl) {
+    add_ref(other.m_impl);
+    release_ref(m_impl);
     m_impl = other.m_impl;
   }
 
@@ -43,6 +66,8 @@ ConfigObject&
 ConfigObject::operator=(ConfigObjectImpl *impl) noexcept
 {
   if(m_impl != impl) {
+    add_ref(impl);
+    release_ref(m_impl);
     m_impl = impl;
   }
 
@@ -54,6 +79,8 @@ ConfigObject::operator==(const ConfigObject& other) const noexcept
 {
   if(this == &other || m_impl == other.m_impl) return true;  // the objects or implementations are the same
   if(!m_impl || !other.m_impl) return false;                 // only one of objects has no implementation
+  if(m_impl->m_impl == other.m_impl->m_impl && m_impl->m_impl) // IDs and class names are interned by the same implementation
+    return ((m_impl->m_id_ptr == other.m_impl->m_id_ptr) && (m_impl->m_class_name == other.m_impl->m_class_name));
   return ((UID() == other.UID()) && (class_name() == other.class_name()));
 }
 
@@ -83,6 +110,100 @@ ConfigObject::get_configuration() const
   return m_impl->m_impl->m_conf;
 }
 
+void
+ConfigObject::referenced_by(std::vector<ConfigObject>& value, const std::string& relationship_name, bool check_composite_only, unsigned long rlevel, const std::vector<std::string> * rclasses) const
+{
+  if (check_composite_only == false)
+    if (Configuration * db = get_configuration(); db && db->m_use_references_index.load(std::memory_order_relaxed))
+      {
+        db->_referenced_by(*this, relationship_name, value, rlevel, rclasses);
+        return;
+      }
+
+  m_impl->referenced_by(value, relationship_name, check_composite_only, rlevel, rclasses);
+}
+
+void
+ConfigObject::get_all(std::vector<attribute_value_t>& values)
+{
+  get_all(get_configuration()->get_class_info(class_name()), values);
+}
+
+void
+ConfigObject::get_all(const class_t& description, std::vector<attribute_value_t>& values)
+{
+  m_impl->get_batch(description, values);
+
+  if (get_configuration()->m_has_converters.load(std::memory_order_relaxed))
+    for (std::size_t i = 0; i < values.size(); ++i)
+      std::visit([&](auto& value) { m_impl->convert(value, *this, description.p_attributes[i].p_name); }, values[i]);
+}
+
+void
+ConfigObject::get(const AttributeHandle& attribute, attribute_value_t& value)
+{
+  m_impl->get_value(*attribute.p_attribute, value);
+
+  if (get_configuration()->m_has_converters.load(std::memory_order_relaxed))
+    std::visit([&](auto& x) { m_impl->convert(x, *this, attribute.name()); }, value);
+}
+
+ConfigObjectImpl *
+ConfigObject::writable_impl()
+{
+  if (m_impl && m_impl->m_impl)
+    get_configuration()->leave_snapshot_cache(*this);
+
+  return m_impl;
+}
+
+void
+ConfigObject::set_obj(const std::string& name, const ConfigObject * o, bool skip_non_null_check)
+{
+  ConfigObjectImpl * impl = writable_impl();
+
+  if (o && !o->is_null())
+    {
+      ConfigObject value(*o);
+      get_configuration()->leave_snapshot_cache(value);
+      impl->set(name, &value, skip_non_null_check);
+    }
+  else
+    {
+      impl->set(name, o, skip_non_null_check);
+    }
+
+  action_on_object_update(get_configuration(), name);
+}
+
+void
+ConfigObject::set_objs(const std::string& name, const std::vector<const ConfigObject*> & o, bool skip_non_null_check)
+{
+  ConfigObjectImpl * impl = writable_impl();
+
+  std::vector<ConfigObject> values;
+  std::vector<const ConfigObject*> ptrs;
+
+  values.reserve(o.size());
+  ptrs.reserve(o.size());
+
+  for (const auto& x : o)
+    {
+      if (x == nullptr || x->is_null())
+        {
+          ptrs.push_back(x);
+          continue;
+        }
+
+      ConfigObject& value(values.emplace_back(*x));  // the values are reserved, so the pointers remain valid
+      get_configuration()->leave_snapshot_cache(value);
+      ptrs.push_back(&value);
+    }
+
+  impl->set(name, ptrs, skip_non_null_check);
+  action_on_object_update(get_configuration(), name);
+}
+
 void
 ConfigObject::rename(const std::string& new_id)
 {
@@ -1,5 +1,9 @@
+#include <sstream>
+
 #include "conffwk/ConfigObject.hpp"
 #include "conffwk/ConfigObjectImpl.hpp"
+#include "conffwk/ConfigurationImpl.hpp"
+#include "conffwk/string_table.hpp"
 
 namespace dunedaq {
 namespace conffwk {
@@ -22,6 +26,10 @@ class ConfigObjectDefault : public ConfigObjectImpl {
 
     virtual const std::string contained_in() const { bad(); return s_invalid; }
 
+    virtual void get_batch(const class_t& /*description*/, std::vector<attribute_value_t>& /*values*/) { bad(); }
+
+    using ConfigObjectImpl::get;  // the methods reading values using handles fall back to the ones below
+
     virtual void get(const std::string& /*attribute*/,   bool&           /*value*/) { bad(); }
     virtual void get(const std::string& /*attribute*/,   uint8_t&        /*value*/) { bad(); }
     virtual void get(const std::string& /*attribute*/,   int8_t&         /*value*/) { bad(); }
@@ -101,14 +109,142 @@ class ConfigObjectDefault : public ConfigObjectImpl {
 
 };
 
-ConfigObjectImpl::ConfigObjectImpl(ConfigurationImpl * impl, const std::string& id, dunedaq::conffwk::ObjectState state) noexcept : m_impl (impl), m_state(state), m_id(id), m_class_name(nullptr)
+  // generation of objects without implementation never changes
+
+static const std::atomic<unsigned long> s_no_generation(0);
+
+  // IDs of objects without implementation and of orphans, which outlive the IDs table of their implementation;
+  // the table is never destroyed, since the orphans can be released after exit of main()
+
+static conffwk::string_table&
+detached_ids() noexcept
+{
+  static conffwk::string_table * s_ids = new conffwk::string_table();
+  return *s_ids;
+}
+
+ConfigObjectImpl::ConfigObjectImpl(ConfigurationImpl * impl, const std::string& id, dunedaq::conffwk::ObjectState state) noexcept :
+  m_impl (impl),
+  m_state(state),
+  m_id_ptr(impl ? &impl->m_ids.intern(id) : &detached_ids().intern(id)),
+  m_class_name(nullptr),
+  m_class_id(static_cast<std::size_t>(-1)),
+  m_generation(impl ? impl->m_generation.load() : 0),
+  m_impl_generation(impl ? &impl->m_generation : &s_no_generation),
+  m_refs(0),
+  m_last_used(0),
+  m_accessed(false),
+  m_pool(nullptr)
+{
+}
+
+bool
+ConfigObjectImpl::orphan() noexcept
+{
+    {
+      std::lock_guard<std::mutex> scoped_lock(m_mutex);
+      m_id_ptr = &detached_ids().intern(*m_id_ptr);  // the IDs table of implementation is cleared by ConfigurationImpl::clean()
+    }
+
+  m_impl = nullptr;
+  m_impl_generation = &s_no_generation;
+  m_generation = 0;
+  m_state = dunedaq::conffwk::Deleted;
+
+  return (m_refs.fetch_or(s_orphan, std::memory_order_acq_rel) != 0);
+}
+
+void
+ConfigObjectImpl::destroy_orphan(ConfigObjectImpl * obj) noexcept
 {
+  // the pool of orphans is released with the last of them; the orphans may be released by different threads
+  static std::mutex s_mutex;
+  std::lock_guard<std::mutex> scoped_lock(s_mutex);
+
+  conffwk::pool * p = obj->m_pool;
+
+  if (p == nullptr)
+    {
+      delete obj; // not created by ConfigurationImpl::insert_object()
+      return;
+    }
+
+  obj->~ConfigObjectImpl();
+  p->deallocate(obj);
+
+  if (p->size() == 0)
+    delete p;
+}
+
+void
+ConfigObjectImpl::unread() noexcept
+{
+  unsigned long generation = m_generation.load();
+  const unsigned long current = m_impl_generation->load(std::memory_order_acquire);
+
+  // only one thread applies the unread
+  if (generation != current && m_generation.compare_exchange_strong(generation, current))
+    {
+      clear();
+      m_state = m_impl->m_unread_state.load(std::memory_order_relaxed);
+    }
 }
 
 ConfigObjectImpl::~ConfigObjectImpl() noexcept
 {
 }
 
+  // read single-value or multi-value attribute
+
+template<class T>
+  static void
+  read_value(ConfigObjectImpl& obj, const std::string& name, bool is_multi_value, attribute_value_t& value)
+  {
+    if (is_multi_value)
+      obj.get(name, value.emplace<std::vector<T>>());
+    else
+      obj.get(name, value.emplace<T>());
+  }
+
+void
+ConfigObjectImpl::get_value(const attribute_t& a, attribute_value_t& value)
+{
+  switch (a.p_type)
+    {
+      case dunedaq::conffwk::string_type:
+      case dunedaq::conffwk::enum_type:
+      case dunedaq::conffwk::date_type:
+      case dunedaq::conffwk::time_type:
+      case dunedaq::conffwk::class_type:  read_value<std::string>(*this, a.p_name, a.p_is_multi_value, value); break;
+      case dunedaq::conffwk::bool_type:   read_value<bool>(*this, a.p_name, a.p_is_multi_value, value);        break;
+      case dunedaq::conffwk::u8_type:     read_value<uint8_t>(*this, a.p_name, a.p_is_multi_value, value);     break;
+      case dunedaq::conffwk::s8_type:     read_value<int8_t>(*this, a.p_name, a.p_is_multi_value, value);      break;
+      case dunedaq::conffwk::u16_type:    read_value<uint16_t>(*this, a.p_name, a.p_is_multi_value, value);    break;
+      case dunedaq::conffwk::s16_type:    read_value<int16_t>(*this, a.p_name, a.p_is_multi_value, value);     break;
+      case dunedaq::conffwk::u32_type:    read_value<uint32_t>(*this, a.p_name, a.p_is_multi_value, value);    break;
+      case dunedaq::conffwk::s32_type:    read_value<int32_t>(*this, a.p_name, a.p_is_multi_value, value);     break;
+      case dunedaq::conffwk::u64_type:    read_value<uint64_t>(*this, a.p_name, a.p_is_multi_value, value);    break;
+      case dunedaq::conffwk::s64_type:    read_value<int64_t>(*this, a.p_name, a.p_is_multi_value, value);     break;
+      case dunedaq::conffwk::float_type:  read_value<float>(*this, a.p_name, a.p_is_multi_value, value);       break;
+      case dunedaq::conffwk::double_type: read_value<double>(*this, a.p_name, a.p_is_multi_value, value);      break;
+      default:
+        {
+          std::ostringstream text;
+          text << "attribute \'" << a.p_name << "\' of object \'" << UID() << '@' << class_name() << "\' has unknown type";
+          throw dunedaq::conffwk::Generic(ERS_HERE, text.str().c_str());
+        }
+    }
+}
+
+void
+ConfigObjectImpl::get_batch(const class_t& description, std::vector<attribute_value_t>& values)
+{
+  values.resize(description.p_attributes.size());
+
+  for (std::size_t i = 0; i < values.size(); ++i)
+    get_value(description.p_attributes[i], values[i]);
+}
+
 ConfigObjectImpl *ConfigObjectImpl::default_impl() noexcept
 {
   return new ConfigObjectDefault();
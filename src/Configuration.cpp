@@ -1,10 +1,20 @@
+#include <limits.h>
 #include <stdlib.h>
+#include <algorithm>
+#include <cerrno>
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <iomanip>
 #include <iostream>
 #include <regex>
 #include <sstream>
+#include <thread>
 #include <unordered_map>
 
 #include <dlfcn.h>
+#include <unistd.h>
 
 #include "ers/ers.hpp"
 #include "ers/internal/SingletonCreator.hpp"
@@ -18,6 +28,8 @@
 #include "conffwk/Configuration.hpp"
 #include "conffwk/ConfigurationImpl.hpp"
 #include "conffwk/Schema.hpp"
+#include "conffwk/Snapshot.hpp"
+#include "conffwk/SnapshotCache.hpp"
 
 namespace dunedaq {
 
@@ -79,6 +91,15 @@ Configuration::remove_action(ConfigAction * ac)
 void
 Configuration::action_on_update(const ConfigObject& obj, const std::string& name)
 {
+  // local modification is not reported by update_cache(), so rebuild attribute indices and drop the index of references
+  outdate_indices();
+
+  if (m_use_references_index.load(std::memory_order_relaxed))
+    {
+      std::lock_guard<std::mutex> scoped_lock(m_impl_mutex);
+      reset_references_index();
+    }
+
   std::lock_guard<std::mutex> scoped_lock(m_actn_mutex);
   for (auto &i : m_actions)
     i->update(obj, name);
@@ -96,8 +117,11 @@ check_prefetch_needs()
 
 
 Configuration::Configuration(const std::string& spec) :
-    p_number_of_cache_hits(0), p_number_of_template_object_created(0), p_number_of_template_object_read(0), m_impl(nullptr), m_shlib_h(nullptr)
+    m_indices_outdated(false), m_use_references_index(false), p_number_of_cache_hits(0), p_number_of_template_object_created(0), p_number_of_template_object_read(0), m_generation(0), m_has_converters(false), m_impl(nullptr), m_shlib_h(nullptr), m_impl_creator(nullptr), m_snapshot_impl(nullptr)
 {
+  for (auto& x : m_converters)
+    x.store(nullptr, std::memory_order_relaxed);
+
   std::string s;
 
   if (spec.empty())
@@ -157,9 +181,14 @@ Configuration::Configuration(const std::string& spec) :
     }
 
 
-    // create implementation
+    // create implementation, unless the database is read from snapshot
+
+  m_impl_creator = f;
+
+  const bool from_snapshot = (!m_impl_param.empty() && use_snapshot_cache(m_impl_param));
 
-  m_impl = (*f)(m_impl_param);
+  if (!from_snapshot)
+    m_impl = (*f)(m_impl_param);
 
   if (m_impl)
     {
@@ -168,8 +197,32 @@ Configuration::Configuration(const std::string& spec) :
       m_impl->set(this);
     }
 
+  if (const char * s = getenv("TDAQ_DB_CACHE_LIMIT"))
+    {
+      char * end = nullptr;
+      unsigned long long limit = strtoull(s, &end, 10);
+
+      if (*s == 0 || *end != 0)
+        {
+          std::ostringstream text;
+          text << "bad value \'" << s << "\' of TDAQ_DB_CACHE_LIMIT environment variable (expect size in bytes)";
+          throw dunedaq::conffwk::Generic(ERS_HERE, text.str().c_str());
+        }
+
+      if (m_impl)
+        m_impl->set_cache_limit(limit);
+    }
+
   if (check_prefetch_needs())
-    m_impl->prefetch_all_data();
+    {
+      ConfigurationImpl::untraced_scope untraced;
+      m_impl->prefetch_all_data();
+    }
+  else if (m_impl)
+    replay_access_trace();
+
+  if (!from_snapshot && !m_impl_param.empty() && m_impl && m_impl->loaded())
+    save_snapshot_cache(m_impl_param);
 
   TLOG_DEBUG(2) << "\n*** DUMP CONFIGURATION ***\n" << *this;
 }
@@ -178,6 +231,17 @@ Configuration::Configuration(const std::string& spec) :
 void
 Configuration::print_profiling_info() noexcept
 {
+  std::map<std::string, memory_usage_t> usage;
+
+  try
+    {
+      usage = memory_usage();
+    }
+  catch (const std::exception& ex)
+    {
+      TLOG_DEBUG(1) << "cannot get memory usage: " << ex.what();
+    }
+
   std::lock_guard < std::mutex > scoped_lock(m_impl_mutex);
 
   std::cout << "Configuration profiler report:\n"
@@ -195,8 +259,32 @@ Configuration::print_profiling_info() noexcept
           Cache<DalObject> *c = static_cast<Cache<DalObject>*>(i.second);
           std::cout << "    *** " << c->m_cache.size() << " objects is class \'" << *i.first << "\' were accessed ***\n";
           for (auto & j : c->m_cache)
-            std::cout << "     - object \'" << j.first << '\'' << std::endl;
+            std::cout << "     - object \'" << *j.first << '\'' << std::endl;
+        }
+    }
+
+  if (!usage.empty())
+    {
+      std::size_t total_objects = 0, total_bytes = 0;
+
+      std::cout << "  memory usage of cached objects (number of objects / bytes):\n";
+
+      for (const auto& i : usage)
+        {
+          const memory_usage_t& x(i.second);
+
+          std::cout <<
+            "    class \'" << i.first << "\': "
+            "implementation " << x.p_impl_objects << " / " << x.p_impl_bytes << ", "
+            "template " << x.p_dal_objects << " / " << x.p_dal_bytes << ", "
+            "generated " << x.p_generated_objects << " / " << x.p_generated_bytes << ", "
+            "tangled " << x.p_tangled_objects << " / " << x.p_tangled_bytes << '\n';
+
+          total_objects += x.p_impl_objects + x.p_dal_objects + x.p_generated_objects + x.p_tangled_objects;
+          total_bytes += x.total_bytes();
         }
+
+      std::cout << "    total: " << total_objects << " objects / " << total_bytes << " bytes" << std::endl;
     }
 
   if (m_impl)
@@ -211,6 +299,17 @@ Configuration::~Configuration() noexcept
   if (::getenv("TDAQ_DUMP_CONFFWK_PROFILER_INFO"))
     print_profiling_info();
 
+  if (const char * file_name = ::getenv("TDAQ_DB_ACCESS_TRACE"))
+    if (*file_name && m_impl && m_impl->loaded())
+      try
+        {
+          save_access_trace(file_name);
+        }
+      catch (dunedaq::conffwk::Generic& ex)
+        {
+          ers::error(ex);
+        }
+
   try
     {
       unload();
@@ -234,15 +333,21 @@ Configuration::~Configuration() noexcept
 void
 Configuration::get(const std::string& class_name, const std::string& id, ConfigObject& object, unsigned long rlevel, const std::vector<std::string> * rclasses)
 {
-  std::lock_guard<std::mutex> scoped_lock(m_impl_mutex);
   _get(class_name, id, object, rlevel, rclasses);
+  check_cache_limit();
 }
 
 void
 Configuration::_get(const std::string& class_name, const std::string& name, ConfigObject& object, unsigned long rlevel, const std::vector<std::string> * rclasses)
 {
+    // cache hit path: only the shard of the class is locked
+
+  if (m_impl && m_impl->get_cached_object(class_name, name, &object))
+    return;
+
   try
     {
+      std::lock_guard<std::mutex> scoped_lock(m_impl_mutex);
       m_impl->get(class_name, name, object, rlevel, rclasses);
     }
   catch (dunedaq::conffwk::Generic& ex)
@@ -256,9 +361,24 @@ Configuration::_get(const std::string& class_name, const std::string& name, Conf
 void
 Configuration::get(const std::string& class_name, std::vector<ConfigObject>& objects, const std::string& query, unsigned long rlevel, const std::vector<std::string> * rclasses)
 {
-  try
+  if (!query.empty())
+    {
+      check_snapshot_cache("queried");
+    }
+
     {
       std::lock_guard<std::mutex> scoped_lock(m_impl_mutex);
+      _get(class_name, objects, query, rlevel, rclasses);
+    }
+
+  check_cache_limit();
+}
+
+void
+Configuration::_get(const std::string& class_name, std::vector<ConfigObject>& objects, const std::string& query, unsigned long rlevel, const std::vector<std::string> * rclasses)
+{
+  try
+    {
       m_impl->get(class_name, objects, query, rlevel, rclasses);
     }
   catch (dunedaq::conffwk::Generic& ex)
@@ -276,10 +396,13 @@ Configuration::get(const std::string& class_name, std::vector<ConfigObject>& obj
 void
 Configuration::get(const ConfigObject& obj_from, const std::string& query, std::vector<ConfigObject>& objects, unsigned long rlevel, const std::vector<std::string> * rclasses)
 {
+  ConfigObject from(obj_from);
+  leave_snapshot_cache(from, "queried");
+
   try
     {
       std::lock_guard<std::mutex> scoped_lock(m_impl_mutex);
-      m_impl->get(obj_from, query, objects, rlevel, rclasses);
+      m_impl->get(from, query, objects, rlevel, rclasses);
     }
   catch (dunedaq::conffwk::Generic& ex)
     {
@@ -287,6 +410,8 @@ Configuration::get(const ConfigObject& obj_from, const std::string& query, std::
       text << "failed to get path \'" << query << "\' from object \'" << obj_from << '\'';
       throw dunedaq::conffwk::Generic( ERS_HERE, text.str().c_str(), ex );
     }
+
+  check_cache_limit();
 }
 
 bool
@@ -340,6 +465,9 @@ Configuration::load(const std::string& db_name)
 
   if (m_impl)
     {
+      const bool was_loaded = m_impl->loaded();
+      const bool from_snapshot = (!was_loaded && use_snapshot_cache(name));
+
       m_impl->open_db(name);
       m_impl->get_superclasses(p_superclasses);
       set_subclasses();
@@ -347,8 +475,18 @@ Configuration::load(const std::string& db_name)
 
       if(check_prefetch_needs())
         {
+          ConfigurationImpl::untraced_scope untraced;
           m_impl->prefetch_all_data();
         }
+      else
+        {
+          replay_access_trace();
+        }
+
+      if (!from_snapshot && !was_loaded)
+        {
+          save_snapshot_cache(name);
+        }
 
       TLOG_DEBUG(2) << "\n*** DUMP CONFIGURATION ***\n" << *this;
     }
@@ -364,7 +502,7 @@ Configuration::unload()
   if (m_impl == nullptr)
     throw dunedaq::conffwk::Generic( ERS_HERE, "nothing to unload" );
 
-  std::lock_guard<std::mutex> scoped_lock1(m_tmpl_mutex);  // always lock template objects mutex first
+  std::lock_guard<std::shared_mutex> scoped_lock1(m_tmpl_mutex);  // always lock template objects mutex first
   std::lock_guard<std::mutex> scoped_lock2(m_impl_mutex);
 
   // call conffwk actions if any
@@ -397,27 +535,54 @@ Configuration::unload()
 
       m_impl->unsubscribe();
 
-      for(auto& l : m_convert_map)
-        {
-          for(auto& a : *l.second)
-            delete a;
+      m_has_converters = false;
 
-          delete l.second;
+        // the last published list of a type has all converters of the type
+
+      for(auto& l : m_converters)
+        {
+          if(const converters_t * x = l.exchange(nullptr))
+            for(auto& a : *x)
+              delete a;
         }
 
-      m_convert_map.clear();
+      m_converters_lists.clear();
     }
 
   p_superclasses.clear();
+  m_class_ids.clear();
+  m_class_names.clear();
+  m_superclasses_bits.clear();
+
+    {
+      std::lock_guard<std::shared_mutex> scoped_lock(m_class4algo_mutex);
+      m_class4algo.clear();
+    }
+
+    {
+      std::lock_guard<std::mutex> scoped_lock4(m_index_mutex);
+      m_indices.clear();
+    }
+
+  reset_references_index();
+
+    {
+      std::lock_guard<std::mutex> scoped_lock4(m_desc_mutex);
+
+      for(auto& j : p_direct_classes_desc_cache)
+        delete j.second;
 
-  for(auto& j : p_direct_classes_desc_cache)
-    delete j.second;
+      for(auto& j : p_all_classes_desc_cache)
+        delete j.second;
 
-  for(auto& j : p_all_classes_desc_cache)
-    delete j.second;
+      p_direct_classes_desc_cache.clear();
+      p_all_classes_desc_cache.clear();
+    }
+
+  // the objects of replaced snapshot use IDs interned by the plug-in, so destroy it first
 
-  p_direct_classes_desc_cache.clear();
-  p_all_classes_desc_cache.clear();
+  delete m_snapshot_impl;
+  m_snapshot_impl = nullptr;
 
   m_impl->close_db();
 }
@@ -428,6 +593,8 @@ Configuration::create(const std::string& db_name, const std::list<std::string>&
   if (m_impl == nullptr)
     throw dunedaq::conffwk::Generic( ERS_HERE, "no implementation loaded" );
 
+  check_snapshot_cache("modified");
+
   std::lock_guard<std::mutex> scoped_lock(m_impl_mutex);
 
   try
@@ -472,6 +639,8 @@ Configuration::add_include(const std::string& db_name, const std::string& includ
   if (m_impl == nullptr)
     throw dunedaq::conffwk::Generic( ERS_HERE, "no implementation loaded" );
 
+  check_snapshot_cache("modified");
+
   std::lock_guard<std::mutex> scoped_lock(m_impl_mutex);
 
   try
@@ -494,8 +663,10 @@ Configuration::remove_include(const std::string& db_name, const std::string& inc
   if (m_impl == nullptr)
     throw dunedaq::conffwk::Generic( ERS_HERE, "no implementation loaded" );
 
+  check_snapshot_cache("modified");
+
   std::lock_guard<std::mutex> scoped_lock(m_impl_mutex);
-  std::lock_guard<std::mutex> scoped_lock2(m_tmpl_mutex);
+  std::lock_guard<std::shared_mutex> scoped_lock2(m_tmpl_mutex);
 
   try
     {
@@ -557,6 +728,8 @@ Configuration::set_commit_credentials(const std::string& user, const std::string
   if (m_impl == nullptr)
     throw dunedaq::conffwk::Generic( ERS_HERE, "no implementation loaded" );
 
+  check_snapshot_cache("modified");
+
   std::lock_guard<std::mutex> scoped_lock(m_impl_mutex);
 
   try
@@ -565,263 +738,1620 @@ Configuration::set_commit_credentials(const std::string& user, const std::string
     }
   catch(dunedaq::conffwk::Generic & ex)
     {
-      throw ( dunedaq::conffwk::Generic( ERS_HERE, "set_commit_credentials failed", ex ) );
+      throw ( dunedaq::conffwk::Generic( ERS_HERE, "set_commit_credentials failed", ex ) );
+    }
+}
+
+
+void
+Configuration::commit(const std::string& log_message)
+{
+  TLOG_DEBUG(1) << "call commit";
+
+  if (m_impl == nullptr)
+    throw dunedaq::conffwk::Generic( ERS_HERE, "no implementation loaded");
+
+  check_snapshot_cache("modified");
+
+  std::lock_guard<std::shared_mutex> scoped_lock1(m_tmpl_mutex);  // always lock template objects mutex first
+  std::lock_guard<std::mutex> scoped_lock2(m_impl_mutex);
+
+  try
+    {
+      m_impl->commit(log_message);
+    }
+  catch (dunedaq::conffwk::Generic & ex)
+    {
+      throw(dunedaq::conffwk::Generic( ERS_HERE, "commit failed", ex ) );
+    }
+}
+
+void
+Configuration::abort()
+{
+  TLOG_DEBUG(1) << "call abort";
+
+  if (m_impl == nullptr)
+    throw dunedaq::conffwk::Generic( ERS_HERE, "no implementation loaded");
+
+  std::lock_guard<std::shared_mutex> scoped_lock1(m_tmpl_mutex);  // always lock template objects mutex first
+  std::lock_guard<std::mutex> scoped_lock2(m_impl_mutex);
+
+  try
+    {
+      m_impl->abort();
+      outdate_indices();
+      reset_references_index();
+      _unread_implementation_objects(dunedaq::conffwk::Unknown);
+      _unread_template_objects();
+      m_impl->get_superclasses(p_superclasses);
+      set_subclasses();
+    }
+  catch (dunedaq::conffwk::Generic & ex)
+    {
+      throw(dunedaq::conffwk::Generic( ERS_HERE, "abort failed", ex));
+    }
+}
+
+std::map<std::string, warmup_info_t>
+Configuration::warmup(const std::vector<std::string>& classes, unsigned int threads)
+{
+  typedef std::chrono::steady_clock clock_t;
+
+  auto seconds = [](clock_t::duration d) { return std::chrono::duration<double>(d).count(); };
+
+  // find requested classes and classes of referenced objects
+
+  std::vector<const std::string *> closure;
+  conffwk::fset requested, visited;
+
+  for (const auto& c : classes)
+    {
+      closure.push_back(DalFactory::instance().get_known_class_name_ptr(c));
+      requested.insert(closure.back());
+    }
+
+  for (std::size_t i = 0; i < closure.size(); ++i)
+    {
+      if (visited.insert(closure[i]).second == false)
+        continue;
+
+      for (const auto& r : get_class_info(*closure[i]).p_relationships)
+        {
+          const std::string * c = DalFactory::instance().get_known_class_name_ptr(r.p_type);
+
+          if (visited.find(c) == visited.end())
+            closure.push_back(c);
+        }
+    }
+
+  // read implementation objects and create template objects class by class
+
+  std::map<std::string, warmup_info_t> result;
+  std::vector<std::pair<DalObject *, std::size_t>> objects;       // template object and index of its class in below vectors
+  std::vector<warmup_info_t *> infos;
+  std::vector<std::atomic<clock_t::rep>> init_times(visited.size());
+
+  visited.clear();
+
+  for (const auto& c : closure)
+    {
+      if (visited.insert(c).second == false)
+        continue;
+
+      const DalFactoryFunctions * f = nullptr;
+
+      try
+        {
+          f = &DalFactory::instance().functions(*this, *c, false);
+        }
+      catch (dunedaq::conffwk::Generic& ex)
+        {
+          if (requested.find(c) != requested.end())
+            throw;
+
+          TLOG_DEBUG(1) << "skip warm-up of objects of class \'" << *c << "\': " << ex;
+          continue;
+        }
+
+      warmup_info_t& info(result[*c]);
+      infos.push_back(&info);
+
+      const auto t0 = clock_t::now();
+
+      std::vector<ConfigObject> objs;
+
+        {
+          std::lock_guard<std::mutex> scoped_lock(m_impl_mutex);
+          _get(*c, objs, "", 0, nullptr);
+        }
+
+      const auto t1 = clock_t::now();
+
+      try
+        {
+          std::lock_guard<std::shared_mutex> scoped_lock(m_tmpl_mutex);
+
+          for (auto& o : objs)
+            objects.emplace_back((*f->m_creator_fn)(*this, o, o.UID()), infos.size() - 1);
+        }
+      catch (dunedaq::conffwk::Generic& ex)
+        {
+          std::ostringstream text;
+          text << "failed to create template objects of class \'" << *c << '\'';
+          throw dunedaq::conffwk::Generic( ERS_HERE, text.str().c_str(), ex );
+        }
+
+      info.p_objects = objs.size();
+      info.p_read_time = seconds(t1 - t0);
+      info.p_create_time = seconds(clock_t::now() - t1);
+    }
+
+  // initialize template objects in parallel by shared owners of the template objects mutex (see DalObject::check_init());
+  // the referenced template objects are already created, so the initialization does not need exclusive lock, while the relationships
+  // are still read via plug-in, that resolves them by ConfigurationImpl::insert_object() serializing concurrent calls
+
+  if (threads == 0)
+    threads = std::max(std::thread::hardware_concurrency(), 1U);
+
+  std::atomic<std::size_t> next(0);
+  std::mutex error_mutex;
+  std::exception_ptr error;
+
+  auto worker = [&]()
+    {
+      for (std::size_t i = next++; i < objects.size(); i = next++)
+        {
+          const auto t = clock_t::now();
+
+          try
+            {
+              std::lock_guard<std::mutex> scoped_lock(objects[i].first->m_mutex);
+              objects[i].first->check_init();
+            }
+          catch (...)
+            {
+              std::lock_guard<std::mutex> scoped_lock(error_mutex);
+
+              if (!error)
+                error = std::current_exception();
+
+              next = objects.size();
+            }
+
+          init_times[objects[i].second] += (clock_t::now() - t).count();
+        }
+    };
+
+  std::vector<std::thread> pool;
+
+  for (unsigned int i = 1; i < threads && i < objects.size(); ++i)
+    pool.emplace_back(worker);
+
+  worker();
+
+  for (auto& t : pool)
+    t.join();
+
+  check_cache_limit();
+
+  if (error)
+    {
+      try
+        {
+          std::rethrow_exception(error);
+        }
+      catch (dunedaq::conffwk::Exception& ex)
+        {
+          throw dunedaq::conffwk::Generic( ERS_HERE, "failed to initialize template objects", ex );
+        }
+    }
+
+  for (std::size_t i = 0; i < infos.size(); ++i)
+    infos[i]->p_init_time = seconds(clock_t::duration(init_times[i].load()));
+
+  for (const auto& x : result)
+    TLOG_DEBUG(1) << "warm-up of class \'" << x.first << "\': " << x.second.p_objects << " objects, read " << x.second.p_read_time << " s, create " << x.second.p_create_time << " s, init " << x.second.p_init_time << " s";
+
+  return result;
+}
+
+static const char * s_access_trace_header = "# conffwk access trace: class name<TAB>object id";
+
+static std::size_t
+read_access_trace(const std::string& file_name, std::map<std::string, std::vector<std::string>>& objects)
+{
+  std::ifstream f(file_name);
+
+  if (!f)
+    {
+      std::ostringstream text;
+      text << "cannot open access trace file \'" << file_name << '\'';
+      throw dunedaq::conffwk::Generic(ERS_HERE, text.str().c_str());
+    }
+
+  std::string line;
+  std::size_t count = 0;
+
+  for (unsigned int n = 1; std::getline(f, line); ++n)
+    {
+      if (line.empty() || line[0] == '#')
+        continue;
+
+      std::string::size_type idx = line.find('\t');
+
+      if (idx == std::string::npos || idx == 0 || idx + 1 == line.size())
+        {
+          std::ostringstream text;
+          text << "bad line " << n << " of access trace file \'" << file_name << "\' (expect class name and object id separated by tab)";
+          throw dunedaq::conffwk::Generic(ERS_HERE, text.str().c_str());
+        }
+
+      objects[line.substr(0, idx)].push_back(line.substr(idx + 1));
+      count++;
+    }
+
+  return count;
+}
+
+void
+Configuration::save_access_trace(const std::string& file_name)
+{
+  if (m_impl == nullptr)
+    throw dunedaq::conffwk::Generic( ERS_HERE, "no implementation loaded");
+
+  std::map<std::string, std::set<std::string>> objects;
+  std::size_t count = 0, accessed = 0;
+
+  // the trace is replaced by the objects accessed by this run, so the objects not used anymore are aged out
+
+    {
+      std::lock_guard<std::mutex> scoped_lock(m_impl_mutex);
+
+      // the objects read or found in cache by user requests (prefetched ones are not marked) and the evicted ones
+
+      for (const auto& s : m_impl->m_shards)
+        {
+          std::lock_guard<std::mutex> scoped_lock2(s.m_mutex);
+
+          for (const auto& i : s.m_objects)
+            for (const auto& j : *i.second)
+              if (j.second->m_accessed.load(std::memory_order_relaxed) && j.second->m_state != dunedaq::conffwk::Deleted)
+                {
+                  objects[*i.first].insert(*j.first);
+                  accessed++;
+                }
+        }
+
+      for (const auto& i : m_impl->m_evicted_accessed)
+        for (const auto& j : i.second)
+          {
+            objects[*i.first].insert(*j);
+            accessed++;
+          }
+    }
+
+  if (accessed == 0)
+    {
+      TLOG_DEBUG(1) << "no objects were accessed, keep access trace file \'" << file_name << '\'';
+      return;
+    }
+
+  // write temporary file and rename it, so concurrent processes using the same trace never read a partially written one
+
+  const std::string tmp_name(file_name + '.' + std::to_string(::getpid()));
+
+    {
+      std::ofstream f(tmp_name);
+
+      f << s_access_trace_header << '\n';
+
+      for (const auto& i : objects)
+        {
+          for (const auto& id : i.second)
+            f << i.first << '\t' << id << '\n';
+
+          count += i.second.size();
+        }
+
+      f.close();
+
+      if (!f)
+        {
+          std::ostringstream text;
+          text << "cannot write access trace file \'" << tmp_name << '\'';
+          throw dunedaq::conffwk::Generic(ERS_HERE, text.str().c_str());
+        }
+    }
+
+  if (std::rename(tmp_name.c_str(), file_name.c_str()) != 0)
+    {
+      std::ostringstream text;
+      text << "cannot rename \'" << tmp_name << "\' to access trace file \'" << file_name << "\': " << std::strerror(errno);
+      std::remove(tmp_name.c_str());
+      throw dunedaq::conffwk::Generic(ERS_HERE, text.str().c_str());
+    }
+
+  TLOG_DEBUG(1) << "saved access trace of " << count << " objects of " << objects.size() << " classes to file \'" << file_name << '\'';
+}
+
+void
+Configuration::_prefetch(const std::map<std::string, std::vector<std::string>>& objects)
+{
+  std::map<std::string, std::vector<std::string>> known;
+
+  // skip classes, which are not defined by the schema anymore
+
+  for (const auto& i : objects)
+    {
+      const std::string * name = DalFactory::instance().find_known_class_name(i.first);
+
+      if (name && p_superclasses.find(name) != p_superclasses.end())
+        known.emplace(i.first, i.second);
+      else
+        TLOG_DEBUG(1) << "skip prefetch of " << i.second.size() << " objects of unknown class \'" << i.first << '\'';
+    }
+
+  ConfigurationImpl::untraced_scope untraced;
+  m_impl->prefetch(known);
+}
+
+std::size_t
+Configuration::prefetch_access_trace(const std::string& file_name)
+{
+  if (m_impl == nullptr)
+    throw dunedaq::conffwk::Generic( ERS_HERE, "no implementation loaded");
+
+  std::map<std::string, std::vector<std::string>> objects;
+  const std::size_t count = read_access_trace(file_name, objects);
+
+    {
+      std::lock_guard<std::shared_mutex> scoped_lock1(m_tmpl_mutex);  // always lock template objects mutex first
+      std::lock_guard<std::mutex> scoped_lock2(m_impl_mutex);
+
+      try
+        {
+          _prefetch(objects);
+        }
+      catch (dunedaq::conffwk::Generic & ex)
+        {
+          throw(dunedaq::conffwk::Generic( ERS_HERE, "prefetch of objects from access trace failed", ex));
+        }
+    }
+
+  TLOG_DEBUG(1) << "prefetched " << count << " objects of access trace \'" << file_name << '\'';
+
+  check_cache_limit();
+
+  return count;
+}
+
+void
+Configuration::replay_access_trace() noexcept
+{
+  const char * file_name = getenv("TDAQ_DB_ACCESS_TRACE");
+
+  if (file_name == nullptr || *file_name == 0)
+    return;
+
+  // there is no trace on first run, it is saved by destructor
+
+  if (::access(file_name, R_OK) != 0)
+    {
+      TLOG_DEBUG(1) << "access trace file \'" << file_name << "\' does not exist yet";
+      return;
+    }
+
+  try
+    {
+      std::map<std::string, std::vector<std::string>> objects;
+      const std::size_t count = read_access_trace(file_name, objects);
+      _prefetch(objects);
+      TLOG_DEBUG(1) << "prefetched " << count << " objects of access trace \'" << file_name << '\'';
+    }
+  catch (dunedaq::conffwk::Exception & ex)
+    {
+      ers::warning(dunedaq::conffwk::Generic( ERS_HERE, "failed to prefetch objects from access trace", ex));
+    }
+}
+
+  // find database file in the same way as the file implementation plug-ins do: the relative name is
+  // searched in directory of including file, in the TDAQ_DB_PATH directories and in current directory
+
+static std::string
+resolve_db_file(const std::string& name, const std::string& parent)
+{
+  auto readable = [](const std::string& file) { return (::access(file.c_str(), R_OK) == 0); };
+
+  if (name.empty())
+    return "";
+
+  if (name[0] == '/')
+    return (readable(name) ? name : "");
+
+  if (!parent.empty())
+    {
+      const std::string file(parent.substr(0, parent.find_last_of('/') + 1) + name);
+
+      if (readable(file))
+        return file;
+    }
+
+  if (const char * path = getenv("TDAQ_DB_PATH"))
+    {
+      std::istringstream in(path);
+      std::string dir;
+
+      while (std::getline(in, dir, ':'))
+        if (!dir.empty())
+          {
+            const std::string file(dir + '/' + name);
+
+            if (readable(file))
+              return file;
+          }
+    }
+
+  if (readable(name))
+    {
+      char cwd[PATH_MAX];
+
+      if (::getcwd(cwd, sizeof(cwd)))
+        return std::string(cwd) + '/' + name;
+    }
+
+  return "";
+}
+
+std::string
+Configuration::snapshot_cache_file(const std::string& db_name) const
+{
+  const char * dir = getenv("TDAQ_DB_SNAPSHOT_CACHE");
+
+  if (dir == nullptr || *dir == 0)
+    return "";
+
+  const std::string file(resolve_db_file(db_name, ""));
+
+  if (file.empty())
+    {
+      TLOG_DEBUG(1) << "database \'" << db_name << "\' is not a file, the snapshot cache is not used";
+      return "";
+    }
+
+  // the snapshot of the database is identified by the implementation name and the database file name; the snapshot stores hashes of all database files to detect it is stale
+
+  uint64_t hash = 14695981039346656037ULL;
+
+  for (char c : m_impl_name + ':' + file)
+    {
+      hash ^= static_cast<unsigned char>(c);
+      hash *= 1099511628211ULL;
+    }
+
+  std::ostringstream name;
+  name << dir << '/' << m_impl_name << '-' << std::hex << std::setw(16) << std::setfill('0') << hash << ".snapshot";
+
+  return name.str();
+}
+
+bool
+Configuration::use_snapshot_cache(const std::string& db_name)
+{
+  const std::string file_name(snapshot_cache_file(db_name));
+
+  // the limit set by TDAQ_DB_CACHE_LIMIT or set_cache_limit() is kept by the replacing implementation
+
+  const std::size_t cache_limit = (m_impl ? m_impl->m_cache_limit.load() : 0);
+
+  if (!file_name.empty() && (m_impl == nullptr || !m_impl->loaded()))
+    {
+      if (SnapshotCacheImpl * impl = SnapshotCacheImpl::open(file_name, db_name))
+        {
+          delete m_impl;
+          m_impl = impl;
+          m_impl->set_cache_limit(cache_limit);
+          return true;
+        }
+    }
+
+  // restore implementation plug-in replaced by snapshot of other database
+
+  if (dynamic_cast<SnapshotCacheImpl *>(m_impl) != nullptr && !m_impl->loaded())
+    {
+      delete m_impl;
+      m_impl = nullptr;
+      m_impl = (*m_impl_creator)("");
+
+      if (m_impl == nullptr)
+        throw dunedaq::conffwk::Generic( ERS_HERE, "failed to create implementation");
+
+      m_impl->set_cache_limit(cache_limit);
+    }
+
+  return false;
+}
+
+void
+Configuration::check_snapshot_cache(const char * action) const
+{
+  if (const SnapshotCacheImpl * snapshot = dynamic_cast<const SnapshotCacheImpl *>(m_impl))
+    {
+      std::ostringstream text;
+      text << "database \'" << snapshot->db_name() << "\' read from snapshot cache cannot be " << action << "; call Configuration::leave_snapshot_cache() first";
+      throw dunedaq::conffwk::Generic( ERS_HERE, text.str().c_str() );
+    }
+}
+
+void
+Configuration::leave_snapshot_cache()
+{
+  // the implementation is replaced as by load(); the user guarantees that no other thread uses the configuration
+
+  SnapshotCacheImpl * snapshot = dynamic_cast<SnapshotCacheImpl *>(m_impl);
+
+  if (snapshot == nullptr || !snapshot->loaded())
+    return;
+
+  std::lock_guard<std::shared_mutex> scoped_lock1(m_tmpl_mutex);  // always lock template objects mutex first
+  std::lock_guard<std::mutex> scoped_lock2(m_impl_mutex);
+
+  TLOG_DEBUG(1) << "replace snapshot of database \'" << snapshot->db_name() << "\' by implementation plug-in";
+
+  std::unique_ptr<ConfigurationImpl> impl((*m_impl_creator)(""));
+
+  if (impl == nullptr)
+    throw dunedaq::conffwk::Generic( ERS_HERE, "failed to create implementation");
+
+  // the IDs are used as keys by template objects, indices and implementation objects of snapshot
+
+  impl->m_ids.swap(snapshot->m_ids);
+  impl->set(this);
+
+  try
+    {
+      impl->open_db(snapshot->db_name());
+    }
+  catch (dunedaq::conffwk::Generic& ex)
+    {
+      impl->m_ids.swap(snapshot->m_ids);
+      impl->set(nullptr);
+
+      std::ostringstream text;
+      text << "failed to open database \'" << snapshot->db_name() << "\' read from snapshot by implementation plug-in";
+      throw dunedaq::conffwk::Generic( ERS_HERE, text.str().c_str(), ex );
+    }
+
+  impl->set_cache_limit(snapshot->m_cache_limit);
+
+  m_impl = impl.release();
+  m_snapshot_impl = snapshot;
+
+  for (auto& i : m_cache_map)
+    i.second->m_functions.m_rebind_objects_fn(*this, i.second);
+
+  outdate_indices();
+  reset_references_index();
+}
+
+void
+Configuration::leave_snapshot_cache(ConfigObject& obj, const char * action)
+{
+  if (obj.is_null() || obj.m_impl->m_impl == nullptr || dynamic_cast<SnapshotCacheImpl *>(obj.m_impl->m_impl) == nullptr)
+    return;
+
+  check_snapshot_cache(action);
+
+  const std::string class_name(obj.class_name()), id(obj.UID());
+  _get(class_name, id, obj, 0, nullptr);
+}
+
+void
+Configuration::rebind_template_object(DalObject& obj) noexcept
+{
+  const std::string class_name(obj.p_obj.class_name()), id(obj.p_obj.UID());
+
+  try
+    {
+      ConfigObject o;
+      m_impl->get(class_name, id, o, 0, nullptr);
+
+      std::lock_guard<std::mutex> scoped_lock(obj.m_mutex);
+      obj.set(o);
+    }
+  catch (dunedaq::conffwk::Exception& ex)
+    {
+      TLOG_DEBUG(1) << "keep object \'" << id << '@' << class_name << "\' read from snapshot: " << ex.what();
+    }
+}
+
+void
+Configuration::save_snapshot_cache(const std::string& db_name) noexcept
+{
+  const std::string file_name(snapshot_cache_file(db_name));
+
+  if (file_name.empty())
+    return;
+
+  // the objects read to write the snapshot are released afterwards, so they do not defeat lazy loading and the cache limit
+
+  std::unordered_set<const ConfigObjectImpl *> cached;
+  bool release = false;
+
+  try
+    {
+      ConfigurationImpl::untraced_scope untraced;  // the snapshot reads all objects, they are not accessed by the process
+
+      cached = m_impl->cached_impl_objects();
+      release = true;
+
+      SnapshotCacheImpl::contents_t contents;
+      contents.p_db_name = db_name;
+
+      // the database file and included files (recursively)
+
+      std::set<std::string> files;
+      std::list<std::pair<std::string, std::string>> queue { { db_name, "" } };
+
+      auto resolve = [](const std::string& name, const std::string& parent) -> std::string
+        {
+          std::string file(resolve_db_file(name, parent));
+
+          if (file.empty())
+            {
+              std::ostringstream text;
+              text << "cannot find database file \'" << name << '\'';
+              throw dunedaq::conffwk::Generic(ERS_HERE, text.str().c_str());
+            }
+
+          return file;
+        };
+
+      while (!queue.empty())
+        {
+          const std::string name(queue.front().first);
+          const std::string file(resolve(name, queue.front().second));
+          queue.pop_front();
+
+          if (files.insert(file).second == false)
+            continue;
+
+          std::list<std::string>& includes(contents.p_includes[name]);
+          m_impl->get_includes(name, includes);
+
+          for (const auto& i : includes)
+            queue.emplace_back(i, file);
+        }
+
+      // classes and objects; the values of attributes are stored as read from implementation, so converters are applied when they are read from snapshot
+
+      for (const auto& c : p_superclasses)
+        contents.p_classes.emplace_back(std::unique_ptr<class_t>(m_impl->get(*c.first, false)), std::unique_ptr<class_t>(m_impl->get(*c.first, true)));
+
+      for (const auto& c : contents.p_classes)
+        {
+          const class_t& d(*c.first);
+
+          std::vector<ConfigObject> objects;
+          m_impl->get(d.p_name, objects, "", 0, nullptr);
+
+          for (auto& o : objects)
+            if (o.class_name() == d.p_name)
+              {
+                SnapshotCacheImpl::object_t& x(contents.p_objects.emplace_back());
+
+                x.p_id = o.UID();
+                x.p_class_name = d.p_name;
+                x.p_file = resolve(o.contained_in(), "");
+                files.insert(x.p_file);
+
+                o.m_impl->get_batch(d, x.p_values);
+
+                x.p_refs.resize(d.p_relationships.size());
+
+                for (std::size_t i = 0; i < d.p_relationships.size(); ++i)
+                  {
+                    std::vector<ConfigObject> refs;
+                    o.m_impl->rel(d.p_relationships[i].p_name, refs);
+
+                    for (const auto& r : refs)
+                      if (!r.is_null())
+                        x.p_refs[i].emplace_back(r.class_name(), r.UID());
+                  }
+              }
+        }
+
+      for (const auto& f : files)
+        {
+          SnapshotCacheImpl::file_t& x(contents.p_files.emplace_back());
+          x.p_name = f;
+
+          if (SnapshotCacheImpl::read_file_info(x) == false)
+            {
+              std::ostringstream text;
+              text << "cannot read database file \'" << f << '\'';
+              throw dunedaq::conffwk::Generic(ERS_HERE, text.str().c_str());
+            }
+        }
+
+      SnapshotCacheImpl::write(file_name, contents);
+    }
+  catch (dunedaq::conffwk::Exception & ex)
+    {
+      std::ostringstream text;
+      text << "failed to write snapshot of database \'" << db_name << "\' to file \'" << file_name << '\'';
+      ers::warning(dunedaq::conffwk::Generic( ERS_HERE, text.str().c_str(), ex));
+    }
+  catch (std::exception & ex)
+    {
+      std::ostringstream text;
+      text << "failed to write snapshot of database \'" << db_name << "\' to file \'" << file_name << '\'';
+      ers::warning(dunedaq::conffwk::Generic( ERS_HERE, text.str().c_str(), ex));
+    }
+
+  if (release)
+    m_impl->release_impl_objects(cached);
+}
+
+void
+Configuration::prefetch_all_data()
+{
+  std::lock_guard<std::shared_mutex> scoped_lock1(m_tmpl_mutex);  // always lock template objects mutex first
+  std::lock_guard<std::mutex> scoped_lock2(m_impl_mutex);
+
+  try
+    {
+      ConfigurationImpl::untraced_scope untraced;
+      m_impl->prefetch_all_data();
+    }
+  catch (dunedaq::conffwk::Generic & ex)
+    {
+      throw(dunedaq::conffwk::Generic( ERS_HERE, "prefetch all data failed", ex));
+    }
+}
+
+void
+Configuration::set_cache_limit(std::size_t limit)
+{
+  if (m_impl == nullptr)
+    throw dunedaq::conffwk::Generic( ERS_HERE, "no implementation loaded" );
+
+  std::lock_guard<std::shared_mutex> scoped_lock1(m_tmpl_mutex);  // always lock template objects mutex first
+  std::lock_guard<std::mutex> scoped_lock2(m_impl_mutex);
+
+  m_impl->set_cache_limit(limit);
+  m_impl->evict_impl_objects();
+}
+
+std::size_t
+Configuration::get_cache_limit() const noexcept
+{
+  return (m_impl ? m_impl->m_cache_limit.load() : 0);
+}
+
+  // approximate size of nodes and buckets of std::unordered_map used as cache index
+
+template<class M>
+  static std::size_t
+  index_size(const M& m) noexcept
+  {
+    return m.size() * (sizeof(typename M::value_type) + sizeof(void*)) + m.bucket_count() * sizeof(void*);
+  }
+
+std::map<std::string, memory_usage_t>
+Configuration::memory_usage()
+{
+  std::map<std::string, memory_usage_t> result;
+
+  if (m_impl == nullptr)
+    return result;
+
+  std::lock_guard<std::shared_mutex> scoped_lock1(m_tmpl_mutex);  // always lock template objects mutex first
+  std::lock_guard<std::mutex> scoped_lock2(m_impl_mutex);
+
+  auto impl_object_size = [](const ConfigObjectImpl * obj) -> std::size_t {
+    return (obj->m_pool ? obj->m_pool->block_size() : sizeof(ConfigObjectImpl));
+  };
+
+  for (const auto& i : m_cache_map)
+    i.second->m_functions.m_memory_usage_fn(i.second, result[*i.first]);
+
+  for (const auto& s : m_impl->m_shards)
+    {
+      for (const auto& i : s.m_objects)
+        {
+          memory_usage_t& x(result[*i.first]);
+
+          x.p_impl_objects += i.second->size();
+          x.p_impl_bytes += index_size(*i.second);
+
+          for (const auto& j : *i.second)
+            x.p_impl_bytes += impl_object_size(j.second);
+        }
+
+        // the superclass index only refers objects accounted above; count its entries for the superclass
+
+      for (const auto& i : s.m_subclasses_objects)
+        result[*i.first].p_impl_bytes += index_size(*i.second);
+    }
+
+  for (const auto& i : m_impl->m_tangled_objects)
+    {
+      memory_usage_t& x(result[i->class_name()]);
+      x.p_tangled_objects++;
+      x.p_tangled_bytes += impl_object_size(i) + sizeof(ConfigObjectImpl *);
+    }
+
+  return result;
+}
+
+std::shared_ptr<const ConfigurationSnapshot>
+Configuration::snapshot()
+{
+  if (m_impl == nullptr)
+    throw dunedaq::conffwk::Generic( ERS_HERE, "no implementation loaded");
+
+  std::shared_ptr<ConfigurationSnapshot> result(new ConfigurationSnapshot());
+
+  try
+    {
+      // no changes can be applied and no database can be reloaded while the mutex is locked, so the snapshot is consistent
+
+      std::lock_guard<std::mutex> scoped_lock(m_impl_mutex);
+
+      result->p_superclasses = p_superclasses;
+      result->p_subclasses = p_subclasses;
+
+      for (const auto& i : p_superclasses)
+        result->add_class(std::unique_ptr<class_t>(m_impl->get(*i.first, false)));
+
+      for (const auto& i : p_superclasses)
+        {
+          std::vector<ConfigObject> objects;
+          _get(*i.first, objects, "", 0, nullptr);
+
+          for (auto& o : objects)
+            if (o.class_name() == *i.first)
+              result->add_object(o);
+        }
+
+      result->link();
+    }
+  catch (dunedaq::conffwk::Generic& ex)
+    {
+      throw dunedaq::conffwk::Generic( ERS_HERE, "failed to make configuration snapshot", ex );
+    }
+
+  TLOG_DEBUG(2) << "made snapshot of " << result->size() << " objects of " << p_superclasses.size() << " classes";
+
+  check_cache_limit();
+
+  return result;
+}
+
+void
+Configuration::check_cache_limit() noexcept
+{
+  if (m_impl && m_impl->m_cache_limit && m_impl->m_cache_size > m_impl->m_cache_limit)
+    {
+      std::lock_guard<std::shared_mutex> scoped_lock1(m_tmpl_mutex);  // always lock template objects mutex first
+      std::lock_guard<std::mutex> scoped_lock2(m_impl_mutex);
+      m_impl->evict_impl_objects();
+    }
+}
+
+void
+Configuration::_check_cache_limit() noexcept
+{
+  if (m_impl && m_impl->m_cache_limit && m_impl->m_cache_size > m_impl->m_cache_limit)
+    {
+      std::lock_guard<std::mutex> scoped_lock(m_impl_mutex);
+      m_impl->evict_impl_objects();
+    }
+}
+
+void
+Configuration::unread_all_objects(bool unread_implementation_objs) noexcept
+{
+  if (unread_implementation_objs)
+    unread_implementation_objects(dunedaq::conffwk::Unknown);
+
+  unread_template_objects();
+}
+
+
+  // the objects are not touched: they are re-read lazily, when their generation is outdated
+
+void
+Configuration::_unread_template_objects() noexcept
+{
+  m_generation++;
+}
+
+void
+Configuration::_unread_implementation_objects(dunedaq::conffwk::ObjectState state) noexcept
+{
+  if (m_impl)
+    {
+      m_impl->m_unread_state.store(state, std::memory_order_relaxed);
+      m_impl->m_generation.fetch_add(1, std::memory_order_release);
+    }
+}
+
+
+void
+Configuration::set_subclasses() noexcept
+{
+  p_subclasses.clear();
+
+  for (const auto &i : p_superclasses)
+    for (const auto &j : i.second)
+      p_subclasses[j].insert(i.first);
+
+  // assign identifiers in order of class names, so they do not depend on hashing of the pointers
+
+  m_class_names.clear();
+
+  for (const auto &i : p_superclasses)
+    m_class_names.push_back(i.first);
+
+  std::sort(m_class_names.begin(), m_class_names.end(), [](const std::string * a, const std::string * b) { return *a < *b; });
+
+  m_class_ids.clear();
+
+  for (std::size_t i = 0; i < m_class_names.size(); ++i)
+    m_class_ids.emplace(m_class_names[i], i);
+
+  // the DAL classes for algorithms are searched again
+
+  {
+    std::lock_guard<std::shared_mutex> scoped_lock(m_class4algo_mutex);
+    m_class4algo.clear();
+    m_class4algo.resize(m_class_names.size());
+  }
+
+  m_superclasses_bits_row = (m_class_names.size() + 63) / 64;
+  m_superclasses_bits.assign(m_class_names.size() * m_superclasses_bits_row, 0);
+
+  auto set_bit = [this](std::size_t source, std::size_t target) { m_superclasses_bits[source * m_superclasses_bits_row + target / 64] |= (uint64_t(1) << (target % 64)); };
+
+  for (const auto &i : p_superclasses)
+    {
+      const std::size_t source = m_class_ids[i.first];
+
+      set_bit(source, source);
+
+      for (const auto &j : i.second)
+        {
+          const std::size_t target = get_class_id(j);
+
+          if (target != unknown_class_id)
+            set_bit(source, target);
+        }
+    }
+
+  if (m_impl)
+    m_impl->reindex_impl_objects(p_superclasses);
+}
+
+
+//////////////////////////////////////////////////////////////////////////////////////////
+
+  //
+  // Test, create and destroy object methods
+  //
+
+//////////////////////////////////////////////////////////////////////////////////////////
+
+bool
+Configuration::test_object(const std::string& class_name, const std::string& id, unsigned long rlevel, const std::vector<std::string> * rclasses)
+{
+  if (m_impl && m_impl->get_cached_object(class_name, id, nullptr))
+    return true;
+
+  try
+    {
+      std::lock_guard<std::mutex> scoped_lock(m_impl_mutex);
+      return m_impl->test_object(class_name, id, rlevel, rclasses);
+    }
+  catch (dunedaq::conffwk::Generic& ex)
+    {
+      std::ostringstream text;
+      text << "failed to test existence of object \'" << id << '@' << class_name << '\'';
+      throw dunedaq::conffwk::Generic( ERS_HERE, text.str().c_str(), ex );
+    }
+}
+
+void
+Configuration::create(const std::string& at, const std::string& class_name, const std::string& id, ConfigObject& object)
+{
+  check_snapshot_cache("modified");
+
+  try
+    {
+      std::lock_guard<std::mutex> scoped_lock(m_impl_mutex);
+      m_impl->create(at, class_name, id, object);
+      outdate_indices();
+      reset_references_index();
+    }
+  catch (dunedaq::conffwk::Generic& ex)
+    {
+      std::ostringstream text;
+      text << "failed to create object \'" << id << '@' << class_name << '\'';
+      throw dunedaq::conffwk::Generic( ERS_HERE, text.str().c_str(), ex );
+    }
+}
+
+void
+Configuration::create(const ConfigObject& at, const std::string& class_name, const std::string& id, ConfigObject& object)
+{
+  ConfigObject file(at);
+  leave_snapshot_cache(file);
+
+  try
+    {
+      std::lock_guard<std::mutex> scoped_lock(m_impl_mutex);
+      m_impl->create(file, class_name, id, object);
+      outdate_indices();
+      reset_references_index();
+    }
+  catch (dunedaq::conffwk::Generic& ex)
+    {
+      std::ostringstream text;
+      text << "failed to create object \'" << id << '@' << class_name << '\'';
+      throw dunedaq::conffwk::Generic( ERS_HERE, text.str().c_str(), ex );
+    }
+}
+
+
+void
+Configuration::destroy_obj(ConfigObject& object)
+{
+  leave_snapshot_cache(object);
+
+  try
+    {
+      std::lock_guard<std::mutex> scoped_lock(m_impl_mutex);
+      std::lock_guard<std::shared_mutex> scoped_lock2(m_tmpl_mutex);
+      m_impl->destroy(object);
+      outdate_indices();
+      reset_references_index();
+    }
+  catch (dunedaq::conffwk::Generic& ex)
+    {
+      std::ostringstream text;
+      text << "failed to destroy object \'" << object << '\'';
+      throw dunedaq::conffwk::Generic( ERS_HERE, text.str().c_str(), ex );
+    }
+}
+
+
+const std::string&
+Configuration::intern_id(std::string_view id)
+{
+  return m_impl->intern_id(id);
+}
+
+const std::string *
+Configuration::find_id(std::string_view id) const noexcept
+{
+  return m_impl->find_id(id);
+}
+
+void
+Configuration::get_column_values(const std::vector<ConfigObject>& objects, const attribute_t& attribute, std::vector<attribute_value_t>& values)
+{
+  try
+    {
+      m_impl->get_column(objects, attribute, values);
+    }
+  catch (dunedaq::conffwk::Generic& ex)
+    {
+      std::ostringstream text;
+      text << "failed to read values of attribute \'" << attribute.p_name << "\' of " << objects.size() << " objects";
+      throw dunedaq::conffwk::Generic( ERS_HERE, text.str().c_str(), ex );
+    }
+}
+
+void
+Configuration::rename_object(ConfigObject& obj, const std::string& new_id)
+{
+  leave_snapshot_cache(obj);
+
+  std::lock_guard<std::shared_mutex> scoped_impl_lock(m_tmpl_mutex);  // always lock template objects mutex first
+  std::lock_guard<std::mutex> scoped_tmpl_lock(m_impl_mutex);
+
+  std::lock_guard<std::mutex> scoped_obj_lock(obj.m_impl->m_mutex);
+
+  const std::string& old_id(*obj.m_impl->m_id_ptr);
+
+  obj.m_impl->throw_if_deleted();
+  obj.m_impl->rename(new_id);
+  obj.m_impl->m_id_ptr = &m_impl->intern_id(new_id);
+  m_impl->rename_impl_object(obj.m_impl->m_class_name, old_id, new_id);
+  outdate_indices();
+  reset_references_index();
+
+  const std::string& new_uid(*obj.m_impl->m_id_ptr);
+
+  TLOG_DEBUG(3) << " * call rename \'" << old_id << "\' to \'" << new_id << "\' in class \'" << obj.class_name() << "\')";
+
+  conffwk::fmap<CacheBase*>::iterator j = m_cache_map.find(&obj.class_name());
+  if (j != m_cache_map.end())
+    j->second->m_functions.m_rename_object_fn(j->second, old_id, new_uid);
+
+  conffwk::fmap<conffwk::fset>::const_iterator sc = p_superclasses.find(&obj.class_name());
+
+  if (sc != p_superclasses.end())
+    for (conffwk::fset::const_iterator c = sc->second.begin(); c != sc->second.end(); ++c)
+      {
+        conffwk::fmap<CacheBase*>::iterator j = m_cache_map.find(*c);
+
+        if (j != m_cache_map.end())
+          j->second->m_functions.m_rename_object_fn(j->second, old_id, new_uid);
+      }
+}
+
+
+
+//////////////////////////////////////////////////////////////////////////////////////////
+
+  //
+  // Meta-information access methods
+  //
+
+//////////////////////////////////////////////////////////////////////////////////////////
+
+const dunedaq::conffwk::class_t&
+Configuration::get_class_info(const std::string& class_name, bool direct_only)
+{
+  classes_desc_cache_t& d_cache(direct_only ? p_direct_classes_desc_cache : p_all_classes_desc_cache);
+
+    {
+      std::lock_guard<std::mutex> scoped_lock(m_desc_mutex);
+
+      classes_desc_cache_t::const_iterator i = d_cache.find(class_name);
+
+      if (i != d_cache.end())
+        return *(i->second);
+    }
+
+  try
+    {
+      std::lock_guard<std::mutex> scoped_lock(m_impl_mutex);
+
+      dunedaq::conffwk::class_t * d = m_impl->get(class_name, direct_only);
+
+      std::lock_guard<std::mutex> scoped_lock2(m_desc_mutex);
+
+        // another thread could put the description while the m_desc_mutex was unlocked
+
+      auto i = d_cache.try_emplace(class_name, d);
+
+      if (i.second == false)
+        delete d;
+
+      return *i.first->second;
+    }
+  // catch Generic exception only; the NotFound is forwarded from implementation
+  catch (dunedaq::conffwk::Generic& ex)
+    {
+      std::ostringstream text;
+      text << "failed to get description of class \'" << class_name << '\'';
+      throw dunedaq::conffwk::Generic( ERS_HERE, text.str().c_str(), ex );
+    }
+}
+
+dunedaq::conffwk::AttributeHandle
+Configuration::get_attribute_handle(const std::string& class_name, const std::string& name)
+{
+  const dunedaq::conffwk::class_t& c(get_class_info(class_name));
+
+  for (std::size_t i = 0; i < c.p_attributes.size(); ++i)
+    if (c.p_attributes[i].p_name == name)
+      return dunedaq::conffwk::AttributeHandle{DalFactory::instance().get_known_class_name_ptr(class_name), &c.p_attributes[i], i};
+
+  throw dunedaq::conffwk::NotFound(ERS_HERE, "attribute", (name + '@' + class_name).c_str());
+}
+
+dunedaq::conffwk::RelationshipHandle
+Configuration::get_relationship_handle(const std::string& class_name, const std::string& name)
+{
+  const dunedaq::conffwk::class_t& c(get_class_info(class_name));
+
+  for (std::size_t i = 0; i < c.p_relationships.size(); ++i)
+    if (c.p_relationships[i].p_name == name)
+      return dunedaq::conffwk::RelationshipHandle{DalFactory::instance().get_known_class_name_ptr(class_name), &c.p_relationships[i], i};
+
+  throw dunedaq::conffwk::NotFound(ERS_HERE, "relationship", (name + '@' + class_name).c_str());
+}
+
+//////////////////////////////////////////////////////////////////////////////////////////
+
+  //
+  // Index of references
+  //
+
+//////////////////////////////////////////////////////////////////////////////////////////
+
+void
+Configuration::references_index_t::insert(ConfigObject& obj, const std::vector<std::string>& relationships)
+{
+  const object_key_t key(&obj.class_name(), obj.m_impl->m_id_ptr);
+  std::vector<object_key_t>& references(m_references[key]);
+
+  for (const auto& r : relationships)
+    {
+      std::vector<ConfigObject> values;
+
+      if (obj.rel(r, values))
+        for (const auto& v : values)
+          if (!v.is_null())
+            {
+              const object_key_t target(&v.class_name(), v.m_impl->m_id_ptr);
+              m_referenced_by[target].push_back(reference_t{key, &r});
+              references.push_back(target);
+            }
     }
 }
 
-
 void
-Configuration::commit(const std::string& log_message)
+Configuration::references_index_t::remove(const object_key_t& key) noexcept
 {
-  TLOG_DEBUG(1) << "call commit";
+  auto i = m_references.find(key);
 
-  if (m_impl == nullptr)
-    throw dunedaq::conffwk::Generic( ERS_HERE, "no implementation loaded");
-
-  std::lock_guard<std::mutex> scoped_lock1(m_tmpl_mutex);  // always lock template objects mutex first
-  std::lock_guard<std::mutex> scoped_lock2(m_impl_mutex);
+  if (i == m_references.end())
+    return;
 
-  try
-    {
-      m_impl->commit(log_message);
-    }
-  catch (dunedaq::conffwk::Generic & ex)
+  for (const auto& target : i->second)
     {
-      throw(dunedaq::conffwk::Generic( ERS_HERE, "commit failed", ex ) );
+      auto j = m_referenced_by.find(target);
+
+      if (j != m_referenced_by.end())
+        {
+          auto& v(j->second);
+          v.erase(std::remove_if(v.begin(), v.end(), [&key](const reference_t& x) { return x.m_object == key; }), v.end());
+
+          if (v.empty())
+            m_referenced_by.erase(j);
+        }
     }
+
+  m_references.erase(i);
 }
 
 void
-Configuration::abort()
+Configuration::set_references_index(bool enable) noexcept
 {
-  TLOG_DEBUG(1) << "call abort";
+  std::lock_guard<std::mutex> scoped_lock(m_impl_mutex);
 
-  if (m_impl == nullptr)
-    throw dunedaq::conffwk::Generic( ERS_HERE, "no implementation loaded");
+  m_use_references_index = enable;
+  reset_references_index();
+}
 
-  std::lock_guard<std::mutex> scoped_lock1(m_tmpl_mutex);  // always lock template objects mutex first
-  std::lock_guard<std::mutex> scoped_lock2(m_impl_mutex);
+void
+Configuration::build_references_index()
+{
+  auto index = std::make_unique<references_index_t>();
 
-  try
+  for (const auto& i : p_superclasses)
     {
-      m_impl->abort();
-      _unread_implementation_objects(dunedaq::conffwk::Unknown);
-      _unread_template_objects();
-      m_impl->get_superclasses(p_superclasses);
-      set_subclasses();
+      std::vector<std::string>& relationships(index->m_relationships[i.first]);
+
+      const std::unique_ptr<dunedaq::conffwk::class_t> d(m_impl->get(*i.first, false));
+
+      for (const auto& r : d->p_relationships)
+        relationships.push_back(r.p_name);
     }
-  catch (dunedaq::conffwk::Generic & ex)
+
+  for (const auto& i : index->m_relationships)
     {
-      throw(dunedaq::conffwk::Generic( ERS_HERE, "abort failed", ex));
+      if (i.second.empty())
+        continue;
+
+      std::vector<ConfigObject> objects;
+      _get(*i.first, objects, "", 0, nullptr);
+
+      for (auto& o : objects)
+        if (&o.class_name() == i.first)
+          index->insert(o, i.second);
     }
+
+  TLOG_DEBUG(2) << "built index of references of " << index->m_references.size() << " objects";
+
+  m_references_index = std::move(index);
 }
 
 void
-Configuration::prefetch_all_data()
+Configuration::update_references_index(const std::vector<ConfigurationChange *>& changes) noexcept
 {
-  std::lock_guard<std::mutex> scoped_lock1(m_tmpl_mutex);  // always lock template objects mutex first
-  std::lock_guard<std::mutex> scoped_lock2(m_impl_mutex);
+  if (!m_references_index)
+    return;
 
   try
     {
-      m_impl->prefetch_all_data();
+      for (const auto& i : changes)
+        {
+          const std::string * class_name = DalFactory::instance().get_known_class_name_ptr(i->get_class_name());
+
+          // an object without interned ID was never read, so it is not indexed
+
+          for (const auto& id : i->get_removed_objs())
+            if (const std::string * x = m_impl->find_id(id))
+              m_references_index->remove(object_key_t(class_name, x));
+
+          auto r = m_references_index->m_relationships.find(class_name);
+
+          if (r == m_references_index->m_relationships.end())
+            continue;
+
+          for (const auto * ids : { &i->get_created_objs(), &i->get_modified_objs() })
+            for (const auto& id : *ids)
+              {
+                if (const std::string * x = m_impl->find_id(id))
+                  m_references_index->remove(object_key_t(class_name, x));
+
+                ConfigObject obj;
+                m_impl->get(*class_name, id, obj, 0, nullptr);
+                m_references_index->insert(obj, r->second);
+              }
+        }
     }
-  catch (dunedaq::conffwk::Generic & ex)
+  catch (dunedaq::conffwk::Exception& ex)
     {
-      throw(dunedaq::conffwk::Generic( ERS_HERE, "prefetch all data failed", ex));
+      ers::error(dunedaq::conffwk::Generic( ERS_HERE, "failed to update index of references, it will be rebuilt", ex));
+      reset_references_index();
     }
 }
 
 void
-Configuration::unread_all_objects(bool unread_implementation_objs) noexcept
+Configuration::_referenced_by(const ConfigObject& obj, const std::string& relationship_name, std::vector<ConfigObject>& objects, unsigned long rlevel, const std::vector<std::string> * rclasses)
 {
-  if (unread_implementation_objs)
-    unread_implementation_objects(dunedaq::conffwk::Unknown);
+  objects.clear();
 
-  unread_template_objects();
-}
+    {
+      std::lock_guard<std::mutex> scoped_lock(m_impl_mutex);
 
+      if (!m_references_index)
+        build_references_index();
 
-void
-Configuration::_unread_template_objects() noexcept
-{
-  for (auto &j : m_cache_map)
-    j.second->m_functions.m_unread_object_fn(j.second);
-}
+      auto i = m_references_index->m_referenced_by.find(object_key_t(&obj.class_name(), obj.m_impl->m_id_ptr));
 
-void
-Configuration::_unread_implementation_objects(dunedaq::conffwk::ObjectState state) noexcept
-{
-  for (auto &i : m_impl->m_impl_objects)
-    for (auto &j : *i.second)
-      {
-        std::lock_guard<std::mutex> scoped_lock(j.second->m_mutex);
-        j.second->clear();
-        j.second->m_state = state;
-      }
+      if (i != m_references_index->m_referenced_by.end())
+        {
+          std::set<object_key_t> found;  // the object may refer to given one via several relationships
 
-  for (auto& x : m_impl->m_tangled_objects)
-    {
-      std::lock_guard<std::mutex> scoped_lock(x->m_mutex);
-      x->clear();
-      x->m_state = state;
+          for (const auto& r : i->second)
+            if ((relationship_name == "*" || *r.m_relationship == relationship_name) && found.insert(r.m_object).second)
+              {
+                ConfigObject o;
+                m_impl->get(*r.m_object.first, *r.m_object.second, o, rlevel, rclasses);
+                objects.push_back(o);
+              }
+        }
     }
+
+  check_cache_limit();
 }
 
+//////////////////////////////////////////////////////////////////////////////////////////
+
+  //
+  // Attribute value indices
+  //
+
+//////////////////////////////////////////////////////////////////////////////////////////
 
 void
-Configuration::set_subclasses() noexcept
+Configuration::attribute_index_t::insert(ConfigObject& obj)
 {
-  p_subclasses.clear();
+  attribute_value_t value;
+  obj.get(m_attribute, value);
 
-  for (const auto &i : p_superclasses)
-    for (const auto &j : i.second)
-      p_subclasses[j].insert(i.first);
+  remove(obj.UID());
+
+  m_objects.emplace(value, obj.UID());
+  m_values.emplace(obj.UID(), std::move(value));
 }
 
+void
+Configuration::attribute_index_t::remove(const std::string& id) noexcept
+{
+  auto i = m_values.find(id);
 
-//////////////////////////////////////////////////////////////////////////////////////////
+  if (i == m_values.end())
+    return;
 
-  //
-  // Test, create and destroy object methods
-  //
+  for (auto r = m_objects.equal_range(i->second); r.first != r.second; ++r.first)
+    if (r.first->second == id)
+      {
+        m_objects.erase(r.first);
+        break;
+      }
 
-//////////////////////////////////////////////////////////////////////////////////////////
+  m_values.erase(i);
+}
 
-bool
-Configuration::test_object(const std::string& class_name, const std::string& id, unsigned long rlevel, const std::vector<std::string> * rclasses)
+void
+Configuration::create_index(const std::string& class_name, const std::string& attribute)
 {
-  try
-    {
-      std::lock_guard<std::mutex> scoped_lock(m_impl_mutex);
-      return m_impl->test_object(class_name, id, rlevel, rclasses);
-    }
-  catch (dunedaq::conffwk::Generic& ex)
+  const AttributeHandle handle(get_attribute_handle(class_name, attribute));
+
+  if (handle.p_attribute->p_is_multi_value)
     {
       std::ostringstream text;
-      text << "failed to test existence of object \'" << id << '@' << class_name << '\'';
-      throw dunedaq::conffwk::Generic( ERS_HERE, text.str().c_str(), ex );
+      text << "cannot create index of multi-value attribute \'" << attribute << "\' of class \'" << class_name << '\'';
+      throw dunedaq::conffwk::Generic( ERS_HERE, text.str().c_str() );
     }
-}
 
-void
-Configuration::create(const std::string& at, const std::string& class_name, const std::string& id, ConfigObject& object)
-{
+  auto index = std::make_unique<attribute_index_t>(handle);
+
   try
     {
+      // no changes can be applied while the mutex is locked, so the index is consistent with the cache
+
       std::lock_guard<std::mutex> scoped_lock(m_impl_mutex);
-      m_impl->create(at, class_name, id, object);
+
+      fill_index(*index);
+
+      std::lock_guard<std::mutex> scoped_lock2(m_index_mutex);
+      m_indices[handle.p_class_name][attribute] = std::move(index);
     }
   catch (dunedaq::conffwk::Generic& ex)
     {
       std::ostringstream text;
-      text << "failed to create object \'" << id << '@' << class_name << '\'';
+      text << "failed to create index of attribute \'" << attribute << "\' of class \'" << class_name << '\'';
       throw dunedaq::conffwk::Generic( ERS_HERE, text.str().c_str(), ex );
     }
+
+  check_cache_limit();
 }
 
 void
-Configuration::create(const ConfigObject& at, const std::string& class_name, const std::string& id, ConfigObject& object)
+Configuration::fill_index(attribute_index_t& index)
 {
-  try
-    {
-      std::lock_guard<std::mutex> scoped_lock(m_impl_mutex);
-      m_impl->create(at, class_name, id, object);
-    }
-  catch (dunedaq::conffwk::Generic& ex)
-    {
-      std::ostringstream text;
-      text << "failed to create object \'" << id << '@' << class_name << '\'';
-      throw dunedaq::conffwk::Generic( ERS_HERE, text.str().c_str(), ex );
-    }
-}
+  std::vector<ConfigObject> objects;
+  _get(*index.m_attribute.p_class_name, objects, "", 0, nullptr);
 
+  for (auto& o : objects)
+    index.insert(o);
+}
 
 void
-Configuration::destroy_obj(ConfigObject& object)
+Configuration::rebuild_indices()
 {
+  std::lock_guard<std::mutex> scoped_lock(m_impl_mutex);
+
+  // another thread may rebuild the indices after the flag was checked; the modifications made during rebuild set it again
+  if (m_indices_outdated.exchange(false, std::memory_order_acq_rel) == false)
+    return;
+
+  std::lock_guard<std::mutex> scoped_lock2(m_index_mutex);
+
+  TLOG_DEBUG(2) << "rebuild attribute indices of " << m_indices.size() << " classes after local modification of the database";
+
   try
     {
-      std::lock_guard<std::mutex> scoped_lock(m_impl_mutex);
-      std::lock_guard<std::mutex> scoped_lock2(m_tmpl_mutex);
-      m_impl->destroy(object);
+      for (auto& c : m_indices)
+        for (auto& i : c.second)
+          {
+            auto index = std::make_unique<attribute_index_t>(i.second->m_attribute);
+            fill_index(*index);
+            i.second = std::move(index);
+          }
     }
   catch (dunedaq::conffwk::Generic& ex)
     {
-      std::ostringstream text;
-      text << "failed to destroy object \'" << object << '\'';
-      throw dunedaq::conffwk::Generic( ERS_HERE, text.str().c_str(), ex );
+      outdate_indices();
+      throw dunedaq::conffwk::Generic( ERS_HERE, "failed to rebuild attribute indices", ex );
     }
 }
 
-
 void
-Configuration::rename_object(ConfigObject& obj, const std::string& new_id)
+Configuration::find_by(const std::string& class_name, const std::string& attribute, const attribute_value_t& value, std::vector<ConfigObject>& objects)
 {
-  std::lock_guard<std::mutex> scoped_impl_lock(m_tmpl_mutex);  // always lock template objects mutex first
-  std::lock_guard<std::mutex> scoped_tmpl_lock(m_impl_mutex);
+  if (m_indices_outdated.load(std::memory_order_acquire))
+    rebuild_indices();
 
-  std::lock_guard<std::mutex> scoped_obj_lock(obj.m_impl->m_mutex);
+  std::vector<std::string> ids;
 
-  const std::string old_id(obj.m_impl->m_id);
+    {
+      std::lock_guard<std::mutex> scoped_lock(m_index_mutex);
 
-  obj.m_impl->throw_if_deleted();
-  obj.m_impl->rename(new_id);
-  obj.m_impl->m_id = new_id;
-  m_impl->rename_impl_object(obj.m_impl->m_class_name, old_id, new_id);
+      const attribute_index_t * index = nullptr;
 
-  TLOG_DEBUG(3) << " * call rename \'" << old_id << "\' to \'" << new_id << "\' in class \'" << obj.class_name() << "\')";
+      auto i = m_indices.find(DalFactory::instance().get_known_class_name_ptr(class_name));
 
-  conffwk::fmap<CacheBase*>::iterator j = m_cache_map.find(&obj.class_name());
-  if (j != m_cache_map.end())
-    j->second->m_functions.m_rename_object_fn(j->second, old_id, new_id);
+      if (i != m_indices.end())
+        {
+          auto j = i->second.find(attribute);
 
-  conffwk::fmap<conffwk::fset>::const_iterator sc = p_superclasses.find(&obj.class_name());
+          if (j != i->second.end())
+            index = j->second.get();
+        }
 
-  if (sc != p_superclasses.end())
-    for (conffwk::fset::const_iterator c = sc->second.begin(); c != sc->second.end(); ++c)
-      {
-        conffwk::fmap<CacheBase*>::iterator j = m_cache_map.find(*c);
+      if (index == nullptr)
+        {
+          std::ostringstream text;
+          text << "there is no index of attribute \'" << attribute << "\' of class \'" << class_name << '\'';
+          throw dunedaq::conffwk::Generic( ERS_HERE, text.str().c_str() );
+        }
 
-        if (j != m_cache_map.end())
-          j->second->m_functions.m_rename_object_fn(j->second, old_id, new_id);
-      }
+      if (!index->m_objects.empty() && index->m_objects.begin()->first.index() != value.index())
+        {
+          std::ostringstream text;
+          text << "the type of value differs from the type of indexed values of attribute \'" << attribute << "\' of class \'" << class_name << '\'';
+          throw dunedaq::conffwk::Generic( ERS_HERE, text.str().c_str() );
+        }
+
+      for (auto r = index->m_objects.equal_range(value); r.first != r.second; ++r.first)
+        ids.push_back(r.first->second);
+    }
+
+  objects.clear();
+  objects.reserve(ids.size());
+
+  for (const auto& id : ids)
+    {
+      ConfigObject obj;
+      _get(class_name, id, obj, 0, nullptr);
+      objects.push_back(obj);
+    }
+
+  check_cache_limit();
 }
 
+void
+Configuration::update_indices(const std::vector<ConfigurationChange *>& changes) noexcept
+{
+  std::lock_guard<std::mutex> scoped_lock(m_index_mutex);
 
+  if (m_indices.empty())
+    return;
 
-//////////////////////////////////////////////////////////////////////////////////////////
+  for (const auto& i : changes)
+    {
+      const std::string * class_name = DalFactory::instance().get_known_class_name_ptr(i->get_class_name());
 
-  //
-  // Meta-information access methods
-  //
+      auto update = [&](const std::string * c)
+        {
+          auto x = m_indices.find(c);
 
-//////////////////////////////////////////////////////////////////////////////////////////
+          if (x == m_indices.end())
+            return;
 
-const dunedaq::conffwk::class_t&
-Configuration::get_class_info(const std::string& class_name, bool direct_only)
-{
-  std::lock_guard<std::mutex> scoped_lock(m_impl_mutex);
+          for (auto& index : x->second)
+            {
+              for (const auto& id : i->get_removed_objs())
+                index.second->remove(id);
+
+              for (const auto * ids : { &i->get_created_objs(), &i->get_modified_objs() })
+                for (const auto& id : *ids)
+                  {
+                    try
+                      {
+                        ConfigObject obj;
+                        m_impl->get(*class_name, id, obj, 0, nullptr);
+                        index.second->insert(obj);
+                      }
+                    catch (dunedaq::conffwk::Exception& ex)
+                      {
+                        index.second->remove(id);
+                        ers::error(dunedaq::conffwk::Generic( ERS_HERE, "failed to update index", ex));
+                      }
+                  }
+            }
+        };
 
-  conffwk::map<dunedaq::conffwk::class_t *>& d_cache(direct_only ? p_direct_classes_desc_cache : p_all_classes_desc_cache);
+      // the indices of class and of its superclasses contain objects of the class
 
-  conffwk::map<dunedaq::conffwk::class_t *>::const_iterator i = d_cache.find(class_name);
+      update(class_name);
 
-  if (i != d_cache.end())
-    return *(i->second);
+      conffwk::fmap<conffwk::fset>::const_iterator sc = p_superclasses.find(class_name);
 
-  try
-    {
-      dunedaq::conffwk::class_t * d = m_impl->get(class_name, direct_only);
-      d_cache[class_name] = d;
-      return *d;
-    }
-  // catch Generic exception only; the NotFound is forwarded from implementation
-  catch (dunedaq::conffwk::Generic& ex)
-    {
-      std::ostringstream text;
-      text << "failed to get description of class \'" << class_name << '\'';
-      throw dunedaq::conffwk::Generic( ERS_HERE, text.str().c_str(), ex );
+      if (sc != p_superclasses.end())
+        for (const auto& c : sc->second)
+          update(c);
     }
 }
 
@@ -1165,6 +2695,8 @@ Configuration::subscribe(const ConfigurationSubscriptionCriteria& criteria, noti
       throw dunedaq::conffwk::Generic( ERS_HERE, "callback function is not defined" );
     }
 
+  check_snapshot_cache("subscribed");
+
   // create callback subscription structure
 
   Configuration::CallbackSubscription * cs = new CallbackSubscription();
@@ -1199,6 +2731,8 @@ Configuration::subscribe(pre_notify user_cb, void * parameter)
   if (!user_cb)
     throw(dunedaq::conffwk::Generic( ERS_HERE, "callback function is not defined" ) );
 
+  check_snapshot_cache("subscribed");
+
   // create callback subscription structure
 
   CallbackPreSubscription * cs = new CallbackPreSubscription();
@@ -1315,17 +2849,21 @@ Configuration::reset_subscription()
 
 
 void
-Configuration::update_impl_objects(conffwk::pmap<conffwk::map<ConfigObjectImpl *> * >& cache, ConfigurationChange& change, const std::string * class_name)
+Configuration::update_impl_objects(conffwk::fmap<conffwk::fmap<ConfigObjectImpl *> * >& cache, const ConfigurationImpl& impl, ConfigurationChange& change, const std::string * class_name)
 {
   if (change.get_removed_objs().empty() == false)
     {
-      conffwk::pmap<conffwk::map<ConfigObjectImpl *> *>::iterator i = cache.find(class_name);
+      conffwk::fmap<conffwk::fmap<ConfigObjectImpl *> *>::iterator i = cache.find(class_name);
 
       if (i != cache.end())
         {
           for (auto & x : change.get_removed_objs())
             {
-              conffwk::map<ConfigObjectImpl *>::iterator j = i->second->find(x);
+              const std::string * id = impl.find_id(x);
+              if (id == nullptr)
+                continue;
+
+              conffwk::fmap<ConfigObjectImpl *>::iterator j = i->second->find(id);
               if (j != i->second->end())
                 {
                   TLOG_DEBUG( 2 ) << "set implementation object " << x << '@' << *class_name << " [" << (void *)j->second << "] deleted";
@@ -1340,13 +2878,17 @@ Configuration::update_impl_objects(conffwk::pmap<conffwk::map<ConfigObjectImpl *
 
   if (change.get_created_objs().empty() == false)
     {
-      conffwk::pmap<conffwk::map<ConfigObjectImpl *> *>::iterator i = cache.find(class_name);
+      conffwk::fmap<conffwk::fmap<ConfigObjectImpl *> *>::iterator i = cache.find(class_name);
 
       if (i != cache.end())
         {
           for (auto & x : change.get_created_objs())
             {
-              conffwk::map<ConfigObjectImpl *>::iterator j = i->second->find(x);
+              const std::string * id = impl.find_id(x);
+              if (id == nullptr)
+                continue;
+
+              conffwk::fmap<ConfigObjectImpl *>::iterator j = i->second->find(id);
               if (j != i->second->end())
                 {
                   TLOG_DEBUG( 2 ) << "re-set created implementation object " << x << '@' << *class_name << " [" << (void *)j->second << ']';
@@ -1360,13 +2902,17 @@ Configuration::update_impl_objects(conffwk::pmap<conffwk::map<ConfigObjectImpl *
 
   if (change.get_modified_objs().empty() == false)
     {
-      conffwk::pmap<conffwk::map<ConfigObjectImpl *> *>::iterator i = cache.find(class_name);
+      conffwk::fmap<conffwk::fmap<ConfigObjectImpl *> *>::iterator i = cache.find(class_name);
 
       if (i != cache.end())
         {
           for (auto & x : change.get_modified_objs())
             {
-              conffwk::map<ConfigObjectImpl *>::iterator j = i->second->find(x);
+              const std::string * id = impl.find_id(x);
+              if (id == nullptr)
+                continue;
+
+              conffwk::fmap<ConfigObjectImpl *>::iterator j = i->second->find(id);
               if (j != i->second->end())
                 {
                   TLOG_DEBUG(2) << "clear implementation object " << x << '@' << *class_name << " [" << (void *)j->second << ']';
@@ -1384,7 +2930,8 @@ Configuration::update_impl_objects(conffwk::pmap<conffwk::map<ConfigObjectImpl *
 }
 
 
-  // note, the std::lock_guard<std::mutex> scoped_lock(conf->m_tmpl_mutex) is already set by caller
+  // note, the m_tmpl_mutex (at least in shared mode), the m_update_mutex and the m_impl_mutex are already locked by caller;
+  // the method must not change structure of the caches: the template and implementation cache hit paths read them concurrently
 
 void
 Configuration::update_cache(std::vector<ConfigurationChange *>& changes) noexcept
@@ -1394,28 +2941,28 @@ Configuration::update_cache(std::vector<ConfigurationChange *>& changes) noexcep
   // Remove deleted and update modified implementation objects first
   for (const auto& i : changes)
     {
-      const std::string * class_name = &DalFactory::instance().get_known_class_name_ref(i->get_class_name());
+      const std::string * class_name = DalFactory::instance().get_known_class_name_ptr(i->get_class_name());
 
-      update_impl_objects(m_impl->m_impl_objects, *i, class_name);
+      update_impl_objects(m_impl->shard(class_name).m_objects, *m_impl, *i, class_name);
 
       // delete/update implementation objects defined in superclasses
       conffwk::fmap<conffwk::fset>::const_iterator sc = p_superclasses.find(class_name);
 
       if (sc != p_superclasses.end())
         for (const auto &c : sc->second)
-          update_impl_objects(m_impl->m_impl_objects, *i, c);
+          update_impl_objects(m_impl->shard(c).m_objects, *m_impl, *i, c);
 
       // delete/update implementation objects defined in subclasses
       sc = p_subclasses.find(class_name);
 
       if (sc != p_subclasses.end())
         for (const auto &c : sc->second)
-          update_impl_objects(m_impl->m_impl_objects, *i, c);
+          update_impl_objects(m_impl->shard(c).m_objects, *m_impl, *i, c);
     }
 
   for (const auto& i : changes)
     {
-      const std::string * class_name = &DalFactory::instance().get_known_class_name_ref(i->get_class_name()); // FIXME: optimise with above
+      const std::string * class_name = DalFactory::instance().get_known_class_name_ptr(i->get_class_name()); // the name is already interned by the loop above, so no lock
 
       // invoke configuration update if there are template objects of given class
 
@@ -1473,6 +3020,11 @@ Configuration::update_cache(std::vector<ConfigurationChange *>& changes) noexcep
 
     }
 
+  update_indices(changes);
+  update_references_index(changes);
+
+  // destroy tangled objects released since previous update; the ones still referenced are checked again on next update
+  m_impl->reclaim_tangled_objects();
 }
 
 
@@ -1494,10 +3046,14 @@ Configuration::system_cb(std::vector<ConfigurationChange *>& changes, Configurat
   }
 
 
-  // update template objects in cache
+  // update template objects in cache; the update does not insert or remove cached objects, so the template objects mutex is locked
+  // in shared mode and the template and implementation cache hits by other threads are not stalled; the update mutex is locked
+  // in exclusive mode, since the template objects initialized in parallel resolve relationships via plug-in, that may revive
+  // the objects removed by the update (see ConfigurationImpl::insert_object()), and the tangled objects are destroyed
   {
-    std::lock_guard<std::mutex> scoped_lock(conf->m_tmpl_mutex);  // always lock template objects mutex first
-    std::lock_guard<std::mutex> scoped_lock2(conf->m_impl_mutex);
+    std::shared_lock<std::shared_mutex> scoped_lock(conf->m_tmpl_mutex);  // always lock template objects mutex first
+    std::lock_guard<std::shared_mutex> scoped_lock2(conf->m_update_mutex);
+    std::lock_guard<std::mutex> scoped_lock3(conf->m_impl_mutex);
     conf->update_cache(changes);
   }
 
@@ -1764,7 +3320,7 @@ Configuration::print(std::ostream &s) const noexcept
 bool
 Configuration::try_cast(const std::string& target, const std::string& source) noexcept
 {
-  return try_cast(&DalFactory::instance().get_known_class_name_ref(target), &DalFactory::instance().get_known_class_name_ref(source));
+  return try_cast(DalFactory::instance().get_known_class_name_ptr(target), DalFactory::instance().get_known_class_name_ptr(source));
 }
 
 bool
@@ -1776,15 +3332,15 @@ Configuration::try_cast(const std::string *target, const std::string *source) no
       return true;
     }
 
-  conffwk::fmap<conffwk::fset>::iterator i = p_superclasses.find(source);
+  const std::size_t source_id = get_class_id(source);
 
-  if (i == p_superclasses.end())
+  if (source_id == unknown_class_id)
     {
       TLOG_DEBUG(2) << "cast \'" << *source << "\' => \'" << *target << "\' is not possible (source class is not loaded)";
       return false;
     }
 
-  if (i->second.find(target) != i->second.end())
+  if (is_a(source_id, get_class_id(target)))
     {
       TLOG_DEBUG(2) << "cast \'" << *source << "\' => \'" << *target << "\' is allowed (use inheritance)";
       return true;
@@ -1795,6 +3351,38 @@ Configuration::try_cast(const std::string *target, const std::string *source) no
   return false;
 }
 
+const std::string&
+Configuration::class4algo(std::size_t class_id, const std::string& class_name, const std::string& algorithm)
+{
+  if (class_id == unknown_class_id)
+    return DalFactory::instance().find_class4algo(*this, class_name, algorithm);
+
+  // search in cache
+
+  {
+    std::shared_lock<std::shared_mutex> scoped_lock(m_class4algo_mutex);
+
+    if (class_id < m_class4algo.size())
+      {
+        auto i = m_class4algo[class_id].find(algorithm);
+
+        if (i != m_class4algo[class_id].end())
+          return *i->second;
+      }
+  }
+
+  // check all DAL classes and cache the result
+
+  const std::string& dal_class = DalFactory::instance().find_class4algo(*this, class_name, algorithm);
+
+  std::lock_guard<std::shared_mutex> scoped_lock(m_class4algo_mutex);
+
+  if (class_id < m_class4algo.size())
+    m_class4algo[class_id].emplace(algorithm, &dal_class);
+
+  return dal_class;
+}
+
 
 std::ostream&
 operator<<(std::ostream &s, const Configuration &c)
@@ -1824,6 +3412,19 @@ Configuration::mk_ref_ex_text(const char * what, const std::string& cname, const
   return text.str();
 }
 
+void
+Configuration::_read_ref(ConfigObject& obj, const std::string& name, const std::string& cname, ConfigObject& res)
+{
+  try
+    {
+      obj.get(name, res);
+    }
+  catch (dunedaq::conffwk::Generic & ex)
+    {
+      throw(dunedaq::conffwk::Generic( ERS_HERE, mk_ref_ex_text("an object", cname, name, obj).c_str(), ex ) );
+    }
+}
+
 
 std::string
 Configuration::mk_ref_by_ex_text(const std::string& cname, const std::string& rname, const ConfigObject& obj) noexcept
@@ -1861,7 +3462,7 @@ Configuration::referenced_by(const DalObject& obj, const std::string& relationsh
   try
     {
       std::vector<ConfigObject> objs;
-      std::lock_guard<std::mutex> scoped_lock(m_tmpl_mutex);
+      std::lock_guard<std::shared_mutex> scoped_lock(m_tmpl_mutex);
 
       obj.p_obj.referenced_by(objs, relationship_name, check_composite_only, rlevel, rclasses);
       return make_dal_objects(objs, upcast_unregistered);
@@ -1994,7 +3595,7 @@ DalObject::get_rel_objects(const std::string &name, bool upcast_unregistered, st
 
   if (const_cast<ConfigObject*>(&p_obj)->rel(name, c_objs))
     {
-      std::lock_guard<std::mutex> scoped_lock(p_db.m_tmpl_mutex);
+      std::lock_guard<std::shared_mutex> scoped_lock(p_db.m_tmpl_mutex);
       p_db.make_dal_objects(c_objs, upcast_unregistered).swap(objs);
       return true;
     }
@@ -2006,7 +3607,7 @@ DalObject::get_rel_objects(const std::string &name, bool upcast_unregistered, st
 bool
 DalObject::get_algo_objects(const std::string &name, std::vector<const DalObject*> &objs) const
 {
-  const std::string &suitable_dal_class = DalFactory::instance().class4algo(p_db, class_name(), name);
+  const std::string &suitable_dal_class = p_db.class4algo(p_obj.m_impl->class_id(), class_name(), name);
 
   TLOG_DEBUG(2) << "suitable class for algorithm " << name << " on object " << this << " is " << suitable_dal_class;
 
@@ -2130,6 +3731,12 @@ DalFactory::functions(const Configuration& db, const std::string& name, bool upc
 
 const std::string&
 DalFactory::class4algo(Configuration& db, const std::string& name, const std::string& algorithm) const
+{
+  return db.class4algo(db.get_class_id(instance().get_known_class_name_ptr(name)), name, algorithm);
+}
+
+const std::string&
+DalFactory::find_class4algo(Configuration& db, const std::string& name, const std::string& algorithm) const
 {
   for (const auto& x : m_classes)
     if (x.second.m_algorithms.find(algorithm) != x.second.m_algorithms.end() && db.try_cast(x.first, name))
@@ -1,5 +1,7 @@
 #include <stdlib.h>
 
+#include <algorithm>
+
 #include "conffwk/Configuration.hpp"
 #include "conffwk/ConfigurationImpl.hpp"
 #include "conffwk/Schema.hpp"
@@ -219,8 +221,15 @@ namespace dunedaq {
 
 
 ConfigurationImpl::ConfigurationImpl() noexcept :
-  p_number_of_cache_hits  (0),
+  m_generation            (0),
+  m_unread_state          (dunedaq::conffwk::Valid),
   p_number_of_object_read (0),
+  m_cache_limit           (0),
+  m_cache_size            (0),
+  m_cache_clock           (0),
+  p_number_of_evicted_objects (0),
+  p_number_of_reread_objects  (0),
+  m_number_of_evicted_accessed (0),
   m_conf                  (0)
 {
 }
@@ -233,96 +242,182 @@ ConfigurationImpl::~ConfigurationImpl()
 void
 ConfigurationImpl::print_cache_info() noexcept
 {
+  unsigned long hits = 0;
+
+  for (const auto& x : m_shards)
+    {
+      std::lock_guard<std::mutex> scoped_lock(x.m_mutex);
+      hits += x.m_hits;
+    }
+
   std::cout <<
     "Configuration implementation profiler report:\n"
     "  number of read objects: " << p_number_of_object_read << "\n"
-    "  number of cache hits: " << p_number_of_cache_hits << std::endl;
+    "  number of cache hits: " << hits << std::endl;
+
+  if (m_cache_limit)
+    std::cout <<
+      "  cache size: " << m_cache_size << " bytes (limit " << m_cache_limit << " bytes)\n"
+      "  number of evicted objects: " << p_number_of_evicted_objects << "\n"
+      "  number of re-read evicted objects: " << p_number_of_reread_objects << std::endl;
 }
 
 ConfigObjectImpl *
-ConfigurationImpl::get_impl_object(const std::string& name, const std::string& id) const noexcept
+ConfigurationImpl::impl_objects_shard::find(const std::string * class_name, const std::string * id) const noexcept
 {
+  conffwk::fmap<conffwk::fmap<ConfigObjectImpl *> *>::const_iterator i = m_objects.find(class_name);
 
-  conffwk::pmap<conffwk::map<ConfigObjectImpl *> *>::const_iterator i = m_impl_objects.find(&name);
+  if (i != m_objects.end())
+    {
+      conffwk::fmap<ConfigObjectImpl *>::const_iterator j = i->second->find(id);
 
-  const std::string * class_name = nullptr;
+      if (j != i->second->end())
+        return j->second;
+    }
+
+    // check implementation objects of subclasses
 
-  if(i != m_impl_objects.end()) {
-    conffwk::map<ConfigObjectImpl *>::const_iterator j = i->second->find(id);
+  i = m_subclasses_objects.find(class_name);
 
-    if(j != i->second->end()) {
-      p_number_of_cache_hits++;
-      TLOG_DEBUG(4) << "\n  * found the object with id = \'" << id << "\' in class \'" << name << '\'' ;
-      return j->second;
+  if (i != m_subclasses_objects.end())
+    {
+      conffwk::fmap<ConfigObjectImpl *>::const_iterator j = i->second->find(id);
+
+      if (j != i->second->end())
+        return j->second;
     }
 
-    class_name = i->first;
+  return nullptr;
+}
 
+const std::string *
+ConfigurationImpl::get_class_name(const std::string& name) const noexcept
+{
+    // the name is often already interned (e.g. it is ConfigObjectImpl::m_class_name), then there is no need to hash the string
 
-      // prepare and print out debug message
+    {
+      const impl_objects_shard& x(shard(&name));
+      std::lock_guard<std::mutex> scoped_lock(x.m_mutex);
 
-    if(ers::debug_level() >= 4) {
-      TLOG_DEBUG(40) << " * there is no object with id = \'" << id << "\' found in the class \'" << name
-                     << "\' that has " << i->second->size() << " objects in cache: ";
-      for(j=i->second->begin(); j != i->second->end();++j) {
-        TLOG_DEBUG(40) << '\'' << j->first << '\'';
-      }
+      if (x.has(&name))
+        return &name;
     }
 
-  }
-  else {
-    class_name = &DalFactory::instance().get_known_class_name_ref(name);
-    TLOG_DEBUG(40) << "  * there is no object with id = \'" << id << "\' found in the class \'" << name
-                   << "\' that has no objects in cache";
-  }
-
-    // check implementation objects of subclasses
+  return DalFactory::instance().get_known_class_name_ptr(name);
+}
 
-  if(m_conf) {
-    conffwk::fmap<conffwk::fset>::const_iterator subclasses = m_conf->subclasses().find(class_name);
+ConfigObjectImpl *
+ConfigurationImpl::find_impl_object(const std::string& name, const std::string * id, ConfigObject * handle) const noexcept
+{
+  const std::string * class_name = get_class_name(name);
 
-    if(subclasses != m_conf->subclasses().end()) {
-      for(conffwk::fset::const_iterator k = subclasses->second.begin(); k != subclasses->second.end(); ++k) {
-        i = m_impl_objects.find(*k);
-        if(i != m_impl_objects.end()) {
-          conffwk::map<ConfigObjectImpl *>::const_iterator j = i->second->find(id);
+  const impl_objects_shard& x(shard(class_name));
+  std::lock_guard<std::mutex> scoped_lock(x.m_mutex);
 
-          if(j != i->second->end()) {
-            p_number_of_cache_hits++;
-            TLOG_DEBUG(40) << "  * found the object with id = \'" << id << "\' in class \'" << *k << '\'';
+  ConfigObjectImpl * obj = x.find(class_name, id);
 
-            return j->second;
-          }
+  if (obj == nullptr)
+    {
+      TLOG_DEBUG(40) << "  * there is no object \'" << *id << "\' in class \'" << name << "\' and it's subclasses";
+      return nullptr;
+    }
 
+  if (handle)
+    {
+      // the object has to be re-read or to be checked by the implementation
+      if (obj->m_state.load(std::memory_order_acquire) != dunedaq::conffwk::Valid || obj->m_generation.load(std::memory_order_relaxed) != m_generation.load(std::memory_order_acquire))
+        return nullptr;
 
-            // prepare and print out debug message
+      *handle = obj;
+    }
 
-          else if(ers::debug_level() >= 4) {
-            TLOG_DEBUG(40) << "  * there is no object with id = \'" << id << "\' found in the class \'" << *k
-                           << "\' that has " << i->second->size() << " objects in cache: ";
-            for(j=i->second->begin(); j != i->second->end();++j) {
-              TLOG_DEBUG(40) << '\'' << j->first << '\'';
-            }
-          }
+  x.m_hits++;
 
+    // the clock is only advanced by reads of new objects, so the hits of readers do not write the same cache line
 
-        }
-        else {
-          TLOG_DEBUG(40) << "  * there is no object with id = \'" << id << "\' found in the class \'" << *k
-                         << "\' that has no objects in cache\n";
-        }
+  if (m_cache_limit)
+    {
+      const unsigned long now = m_cache_clock.load(std::memory_order_relaxed);
 
-      }
+      if (obj->m_last_used.load(std::memory_order_relaxed) != now)
+        obj->m_last_used.store(now, std::memory_order_relaxed);
     }
 
-    TLOG_DEBUG(40) << "  * there is no object \'" << id << "\' in class \'" << name
-                   << "\' and it's subclasses, returning NULL ...";
-  }
-  else {
-    TLOG_DEBUG(40) << "  * there is no object \'" << id << "\' in class \'" << name << "\', returning NULL ...";
+  mark_accessed(obj);
+
+  TLOG_DEBUG(4) << "\n  * found the object with id = \'" << *id << "\' in class \'" << *obj->m_class_name << '\'';
+
+  return obj;
+}
+
+void
+ConfigurationImpl::mark_accessed(ConfigObjectImpl * obj) noexcept
+{
+  // the flag is only set once, so the cache line of the object is not written by every hit
+  if (s_untraced == 0 && !obj->m_accessed.load(std::memory_order_relaxed))
+    obj->m_accessed.store(true, std::memory_order_relaxed);
+}
+
+ConfigObjectImpl *
+ConfigurationImpl::get_impl_object(const std::string& name, const std::string& id) const noexcept
+{
+  const std::string * obj_id = m_ids.find(id);
+
+  if(obj_id == nullptr) {
+    TLOG_DEBUG(40) << "  * there is no object with id = \'" << id << "\' in cache, returning NULL ...";
+    return nullptr;
   }
 
-  return nullptr;
+  return find_impl_object(name, obj_id, nullptr);
+}
+
+bool
+ConfigurationImpl::get_cached_object(const std::string& name, const std::string& id, ConfigObject * object) const noexcept
+{
+  const std::string * obj_id = m_ids.find(id);
+
+  if (obj_id == nullptr)
+    return false;
+
+  ConfigObject x;
+
+  if (find_impl_object(name, obj_id, &x) == nullptr)
+    return false;
+
+  if (object)
+    *object = x;
+
+  return true;
+}
+
+void
+ConfigurationImpl::prefetch(const std::map<std::string, std::vector<std::string>>& objects)
+{
+  for (const auto& i : objects)
+    for (const auto& id : i.second)
+      {
+        if (get_cached_object(i.first, id, nullptr))
+          continue;
+
+        try
+          {
+            ConfigObject obj;
+            get(i.first, id, obj, 0, nullptr);
+          }
+        catch (dunedaq::conffwk::NotFound& ex)
+          {
+            TLOG_DEBUG(3) << "skip prefetch of object \'" << id << '@' << i.first << "\': " << ex.what();
+          }
+      }
+}
+
+void
+ConfigurationImpl::get_column(const std::vector<ConfigObject>& objects, const attribute_t& attribute, std::vector<attribute_value_t>& values)
+{
+  values.resize(objects.size());
+
+  for (std::size_t i = 0; i < objects.size(); ++i)
+    objects[i].m_impl->get_value(attribute, values[i]);
 }
 
 
@@ -331,64 +426,414 @@ ConfigurationImpl::put_impl_object(const std::string& name, const std::string& i
 {
   p_number_of_object_read++;
 
-  conffwk::pmap<conffwk::map<ConfigObjectImpl *> * >::iterator i = m_impl_objects.find(&name);
+  if(obj->m_impl != this || *obj->m_id_ptr != id) {
+    obj->m_id_ptr = &m_ids.intern(id);
+  }
+
+  obj->m_class_name = get_class_name(name);
 
-  if(i != m_impl_objects.end()) {
-    (*i->second)[id] = obj;
-    obj->m_class_name = i->first;
+    {
+      impl_objects_shard& x(shard(obj->m_class_name));
+      std::lock_guard<std::mutex> scoped_lock(x.m_mutex);
+
+      conffwk::fmap<ConfigObjectImpl *> *& m = x.m_objects[obj->m_class_name];
+
+      if (m == nullptr)
+        m = new conffwk::fmap<ConfigObjectImpl *>();
+
+      (*m)[obj->m_id_ptr] = obj;
+    }
+
+  if(m_conf) {
+    index_impl_object(m_conf->superclasses(), obj, true);
   }
-  else {
-    conffwk::map<ConfigObjectImpl *> * m = new conffwk::map<ConfigObjectImpl *>();
-    obj->m_class_name = &DalFactory::instance().get_known_class_name_ref(name);
-    m_impl_objects[obj->m_class_name] = m;
-    (*m)[id] = obj;
+
+  if(obj->m_pool) {
+    m_cache_size += obj->m_pool->block_size();
   }
+
+  mark_accessed(obj);
+
+  if(m_cache_limit) {
+    obj->m_last_used = ++m_cache_clock;
+
+    if(m_evicted_ids.erase(obj->m_id_ptr)) {
+      p_number_of_reread_objects++;
+    }
+  }
+
+  if(m_number_of_evicted_accessed) {
+    conffwk::fmap<conffwk::fset>::iterator i = m_evicted_accessed.find(obj->m_class_name);
+
+    if(i != m_evicted_accessed.end() && i->second.erase(obj->m_id_ptr)) {
+      m_number_of_evicted_accessed--;
+      obj->m_accessed.store(true, std::memory_order_relaxed);
+
+      if(i->second.empty()) {
+        m_evicted_accessed.erase(i);
+      }
+    }
+  }
+}
+
+void
+ConfigurationImpl::index_impl_object(const conffwk::fmap<conffwk::fset>& superclasses, ConfigObjectImpl * obj, bool lock) noexcept
+{
+  obj->m_class_id = m_conf->get_class_id(obj->m_class_name);
+
+  conffwk::fmap<conffwk::fset>::const_iterator sc = superclasses.find(obj->m_class_name);
+
+  if (sc != superclasses.end())
+    for (const auto& c : sc->second)
+      {
+        impl_objects_shard& x(shard(c));
+        std::unique_lock<std::mutex> scoped_lock(x.m_mutex, std::defer_lock);
+
+        if (lock)
+          scoped_lock.lock();
+
+        conffwk::fmap<ConfigObjectImpl *> *& m = x.m_subclasses_objects[c];
+
+        if (m == nullptr)
+          m = new conffwk::fmap<ConfigObjectImpl *>();
+
+        (*m)[obj->m_id_ptr] = obj;
+      }
+}
+
+void
+ConfigurationImpl::reindex_impl_objects(const conffwk::fmap<conffwk::fset>& superclasses) noexcept
+{
+  shards_lock scoped_lock(*this);
+
+  for (auto& x : m_shards)
+    {
+      for (auto& i : x.m_subclasses_objects)
+        delete i.second;
+
+      x.m_subclasses_objects.clear();
+    }
+
+  for (const auto& x : m_shards)
+    for (const auto& i : x.m_objects)
+      for (const auto& j : *i.second)
+        index_impl_object(superclasses, j.second, false);
 }
 
 void
 ConfigurationImpl::rename_impl_object(const std::string * class_name, const std::string& old_id, const std::string& new_id) noexcept
 {
-  conffwk::pmap<conffwk::map<ConfigObjectImpl *> *>::iterator i = m_impl_objects.find(class_name);
+  const std::string * old_obj_id = m_ids.find(old_id);
+
+  if (old_obj_id == nullptr)
+    return;
+
+  shards_lock scoped_lock(*this);
 
-  if (i != m_impl_objects.end())
+  impl_objects_shard& s(shard(class_name));
+
+  conffwk::fmap<conffwk::fmap<ConfigObjectImpl *> *>::iterator i = s.m_objects.find(class_name);
+
+  if (i != s.m_objects.end())
     {
-      conffwk::map<ConfigObjectImpl *>::iterator j = i->second->find(old_id);
+      conffwk::fmap<ConfigObjectImpl *>::iterator j = i->second->find(old_obj_id);
 
       if (j != i->second->end())
         {
-          ConfigObjectImpl*& obj = (*i->second)[new_id];
+          ConfigObjectImpl * obj = j->second;
+          const std::string * new_obj_id = &m_ids.intern(new_id);
 
-          if (obj != nullptr)
+          TLOG_DEBUG(2) << "rename implementation " << (void *)obj << " of object \'" << old_id << '@' << *class_name << "\' to \'" << new_id << '\'';
+          i->second->erase(j);
+
+          ConfigObjectImpl *& x = (*i->second)[new_obj_id];
+
+          if (x != nullptr)
             {
-              obj->m_state = dunedaq::conffwk::Unknown;
-              m_tangled_objects.push_back(obj);
+              x->m_state = dunedaq::conffwk::Unknown;
+              m_tangled_objects.push_back(x);
             }
 
-          obj = j->second;
+          x = obj;
 
-          TLOG_DEBUG(2) << "rename implementation " << (void *)j->second << " of object \'" << old_id << '@' << *class_name << "\' to \'" << new_id << '\'';
-          i->second->erase(j);
+          if (m_conf)
+            {
+              conffwk::fmap<conffwk::fset>::const_iterator sc = m_conf->superclasses().find(class_name);
+
+              if (sc != m_conf->superclasses().end())
+                for (const auto& c : sc->second)
+                  {
+                    impl_objects_shard& xs(shard(c));
+                    conffwk::fmap<conffwk::fmap<ConfigObjectImpl *> *>::iterator k = xs.m_subclasses_objects.find(c);
+
+                    if (k != xs.m_subclasses_objects.end())
+                      {
+                        conffwk::fmap<ConfigObjectImpl *>::iterator y = k->second->find(old_obj_id);
+
+                        if (y != k->second->end() && y->second == obj)
+                          k->second->erase(y);
+
+                        (*k->second)[new_obj_id] = obj;
+                      }
+                  }
+            }
         }
     }
 }
 
+conffwk::pool&
+ConfigurationImpl::get_impl_pool(const std::type_info& type, std::size_t size)
+{
+  conffwk::pool *& p = m_impl_pools[std::type_index(type)];
+
+  if (p == nullptr)
+    p = new conffwk::pool(size);
+
+  return *p;
+}
+
 void
-ConfigurationImpl::clean() noexcept
+ConfigurationImpl::destroy_impl_object(ConfigObjectImpl * obj) noexcept
 {
-  for (auto& i : m_impl_objects)
+  if (conffwk::pool * p = obj->m_pool)
     {
-      for (auto& j : *i.second)
-        delete j.second;
+      obj->~ConfigObjectImpl();
+      p->deallocate(obj);
+    }
+  else
+    {
+      delete obj; // not created by insert_object()
+    }
+}
+
+void
+ConfigurationImpl::set_cache_limit(std::size_t limit) noexcept
+{
+  TLOG_DEBUG(2) << "set cache limit " << limit << " bytes (cache size is " << m_cache_size << " bytes)";
+
+  m_cache_limit = limit;
+
+  if (m_cache_limit == 0)
+    m_evicted_ids.clear();
+}
+
+void
+ConfigurationImpl::evict_impl_objects() noexcept
+{
+  if (m_cache_limit == 0 || m_cache_size <= m_cache_limit)
+    return;
+
+    // evict down to 90% of the limit, so the eviction does not run on every read of new object
+
+  const std::size_t size = m_cache_limit / 10 * 9;
 
-      delete i.second;
+    // lock all shards, so no handle on an unreferenced object can be created via cache hit path
+
+  shards_lock scoped_lock(*this);
+
+  std::vector<ConfigObjectImpl *> objs;
+
+  for (const auto& x : m_shards)
+    for (const auto& i : x.m_objects)
+      for (const auto& j : *i.second)
+        if (j.second->m_refs.load(std::memory_order_acquire) == 0)
+          objs.push_back(j.second);
+
+  std::sort(objs.begin(), objs.end(), [](const ConfigObjectImpl * a, const ConfigObjectImpl * b) { return a->m_last_used < b->m_last_used; });
+
+  for (auto& x : objs)
+    {
+      if (m_cache_size <= size)
+        break;
+
+      evict_impl_object(x);
     }
 
-  m_impl_objects.clear();
+  reclaim_tangled_objects();
+
+  TLOG_DEBUG(2) << "cache size after eviction is " << m_cache_size << " bytes (limit " << m_cache_limit << " bytes)";
+}
+
+void
+ConfigurationImpl::evict_impl_object(ConfigObjectImpl * obj) noexcept
+{
+  TLOG_DEBUG(3) << "evict implementation " << (void *)obj << " of object \'" << *obj->m_id_ptr << '@' << *obj->m_class_name << '\'';
+
+  p_number_of_evicted_objects++;
+
+  if (m_evicted_ids.size() < s_max_evicted_ids)
+    m_evicted_ids.insert(obj->m_id_ptr);
+
+  if (obj->m_accessed.load(std::memory_order_relaxed) && m_number_of_evicted_accessed < s_max_evicted_ids)
+    if (m_evicted_accessed[obj->m_class_name].insert(obj->m_id_ptr).second)
+      m_number_of_evicted_accessed++;
+
+  remove_impl_object(obj);
+}
+
+void
+ConfigurationImpl::remove_impl_object(ConfigObjectImpl * obj) noexcept
+{
+  impl_objects_shard& s(shard(obj->m_class_name));
+  conffwk::fmap<conffwk::fmap<ConfigObjectImpl *> *>::iterator i = s.m_objects.find(obj->m_class_name);
+
+  if (i != s.m_objects.end())
+    {
+      conffwk::fmap<ConfigObjectImpl *>::iterator j = i->second->find(obj->m_id_ptr);
+
+      if (j != i->second->end() && j->second == obj)
+        i->second->erase(j);
+    }
+
+  if (m_conf)
+    {
+      conffwk::fmap<conffwk::fset>::const_iterator sc = m_conf->superclasses().find(obj->m_class_name);
+
+      if (sc != m_conf->superclasses().end())
+        for (const auto& c : sc->second)
+          {
+            impl_objects_shard& xs(shard(c));
+            conffwk::fmap<conffwk::fmap<ConfigObjectImpl *> *>::iterator k = xs.m_subclasses_objects.find(c);
+
+            if (k != xs.m_subclasses_objects.end())
+              {
+                conffwk::fmap<ConfigObjectImpl *>::iterator y = k->second->find(obj->m_id_ptr);
+
+                if (y != k->second->end() && y->second == obj)
+                  k->second->erase(y);
+              }
+          }
+    }
+
+  if (obj->m_pool)
+    m_cache_size -= obj->m_pool->block_size();
+
+  destroy_impl_object(obj);
+}
+
+std::unordered_set<const ConfigObjectImpl *>
+ConfigurationImpl::cached_impl_objects() const
+{
+  std::unordered_set<const ConfigObjectImpl *> objs;
+
+  shards_lock scoped_lock(*this);
+
+  for (const auto& x : m_shards)
+    for (const auto& i : x.m_objects)
+      for (const auto& j : *i.second)
+        objs.insert(j.second);
+
+  return objs;
+}
+
+void
+ConfigurationImpl::release_impl_objects(const std::unordered_set<const ConfigObjectImpl *>& keep) noexcept
+{
+  shards_lock scoped_lock(*this);
+
+  std::vector<ConfigObjectImpl *> objs;
+
+  for (const auto& x : m_shards)
+    for (const auto& i : x.m_objects)
+      for (const auto& j : *i.second)
+        if (j.second->m_refs.load(std::memory_order_acquire) == 0 && keep.find(j.second) == keep.end())
+          objs.push_back(j.second);
+
+  for (auto& x : objs)
+    remove_impl_object(x);
+
+  TLOG_DEBUG(2) << "released " << objs.size() << " objects, cache size is " << m_cache_size << " bytes";
+}
+
+void
+ConfigurationImpl::reclaim_tangled_objects() noexcept
+{
+  if (m_tangled_objects.empty())
+    return;
+
+  const std::size_t num = m_tangled_objects.size();
+
+  auto it = std::remove_if(m_tangled_objects.begin(), m_tangled_objects.end(), [this](ConfigObjectImpl * x)
+    {
+      if (x->m_refs.load(std::memory_order_acquire) != 0)
+        return false;
+
+      if (x->m_pool)
+        m_cache_size -= x->m_pool->block_size();
+
+      destroy_impl_object(x);
+      return true;
+    });
+
+  m_tangled_objects.erase(it, m_tangled_objects.end());
+
+  TLOG_DEBUG(2) << "reclaimed " << (num - m_tangled_objects.size()) << " tangled objects, " << m_tangled_objects.size() << " are still referenced";
+}
+
+void
+ConfigurationImpl::clean() noexcept
+{
+    // an object still referenced by a ConfigObject handle (e.g. kept by user after unload) is detached from
+    // the implementation and is destroyed with the last handle; its pool is released with the last such object
+
+  std::set<conffwk::pool *> used_pools;
+
+  auto release = [&](ConfigObjectImpl * x)
+    {
+      if (x->m_refs.load(std::memory_order_acquire) == 0 || x->orphan() == false)
+        {
+          destroy_impl_object(x);
+        }
+      else if (x->m_pool)
+        {
+          used_pools.insert(x->m_pool);
+        }
+    };
+
+  shards_lock scoped_lock(*this);
+
+  for (auto& x : m_shards)
+    {
+      for (auto& i : x.m_objects)
+        {
+          for (auto& j : *i.second)
+            release(j.second);
+
+          delete i.second;
+        }
+
+      x.m_objects.clear();
+
+      for (auto& i : x.m_subclasses_objects)
+        delete i.second;
+
+      x.m_subclasses_objects.clear();
+    }
 
   for (auto& x : m_tangled_objects)
-    delete x;
+    release(x);
 
   m_tangled_objects.clear();
+
+  for (auto& p : m_impl_pools)
+    if (used_pools.find(p.second) == used_pools.end())
+      delete p.second;
+
+  if (!used_pools.empty())
+    {
+      TLOG_DEBUG(1) << "keep " << used_pools.size() << " memory pool(s) of implementation objects still referenced by ConfigObject handles";
+    }
+
+  m_impl_pools.clear();
+  m_evicted_ids.clear();
+  m_evicted_accessed.clear();
+  m_number_of_evicted_accessed = 0;
+  m_cache_size = 0;
+
+    // the orphans moved their IDs out of the table (see ConfigObjectImpl::orphan()) and the Configuration
+    // dropped template objects and indices using the IDs, so the IDs of removed, renamed and unloaded objects are released
+
+  m_ids.clear();
 }
 
 std::mutex&
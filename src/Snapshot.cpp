@@ -0,0 +1,258 @@
+#include <sstream>
+
+#include "conffwk/ConfigObject.hpp"
+#include "conffwk/Errors.hpp"
+#include "conffwk/Snapshot.hpp"
+
+namespace dunedaq {
+namespace conffwk {
+
+ConfigurationSnapshot::~ConfigurationSnapshot() noexcept
+{
+}
+
+void
+ConfigurationSnapshot::add_class(std::unique_ptr<class_t> description)
+{
+  class_info_t& c = m_classes.emplace_back();
+  c.m_description = std::move(description);
+
+  const class_t& d(*c.m_description);
+
+  for (std::size_t i = 0; i < d.p_attributes.size(); ++i)
+    c.m_attributes.try_emplace(std::string_view(d.p_attributes[i].p_name), i);
+
+  for (std::size_t i = 0; i < d.p_relationships.size(); ++i)
+    c.m_relationships.try_emplace(std::string_view(d.p_relationships[i].p_name), i);
+
+  m_classes_index.try_emplace(std::string_view(d.p_name), &c);
+}
+
+void
+ConfigurationSnapshot::add_object(ConfigObject& obj)
+{
+  const class_info_t * c = find_class(obj.class_name());
+
+  if (c == nullptr)
+    {
+      std::ostringstream text;
+      text << "cannot find description of class of object \'" << obj << '\'';
+      throw dunedaq::conffwk::Generic(ERS_HERE, text.str().c_str());
+    }
+
+  object_t& x = m_objects.emplace_back();
+
+  x.m_id = obj.UID();
+  x.m_class = c;
+
+  const std::string file(obj.contained_in());
+  auto f = m_files_index.find(file);
+
+  if (f == m_files_index.end())
+    {
+      const std::string& s = m_files.emplace_back(file);
+      f = m_files_index.try_emplace(std::string_view(s), &s).first;
+    }
+
+  x.m_file = f->second;
+
+  const class_t& d(*c->m_description);
+
+  obj.get_all(d, x.m_values);
+
+  std::vector<std::vector<ConfigObject>> refs(d.p_relationships.size());
+
+  for (std::size_t i = 0; i < d.p_relationships.size(); ++i)
+    {
+      const relationship_t& r(d.p_relationships[i]);
+
+      if (r.p_cardinality == dunedaq::conffwk::zero_or_many || r.p_cardinality == dunedaq::conffwk::one_or_many)
+        {
+          obj.get(r.p_name, refs[i]);
+        }
+      else
+        {
+          ConfigObject value;
+          obj.get(r.p_name, value);
+
+          if (!value.is_null())
+            refs[i].push_back(value);
+        }
+    }
+
+  m_unlinked.emplace_back(&x, std::move(refs));
+}
+
+void
+ConfigurationSnapshot::link()
+{
+  for (auto& c : m_classes)
+    for (const auto& s : c.m_description->p_superclasses)
+      if (const class_info_t * x = find_class(s))
+        c.m_superclasses.push_back(x);
+
+    // index objects by ID in their classes and superclasses
+
+  for (const auto& x : m_objects)
+    {
+      m_classes_index.find(std::string_view(x.class_name()))->second->m_objects.try_emplace(std::string_view(x.m_id), &x);
+
+      for (const auto& s : x.m_class->m_superclasses)
+        m_classes_index.find(std::string_view(s->m_description->p_name))->second->m_objects.try_emplace(std::string_view(x.m_id), &x);
+    }
+
+    // replace referenced conffwk objects by the objects of snapshot
+
+  for (auto& u : m_unlinked)
+    {
+      u.first->m_refs.resize(u.second.size());
+
+      for (std::size_t i = 0; i < u.second.size(); ++i)
+        {
+          std::vector<const object_t *>& refs(u.first->m_refs[i]);
+          refs.reserve(u.second[i].size());
+
+          for (const auto& o : u.second[i])
+            if (const object_t * y = get(o.class_name(), o.UID()))
+              refs.push_back(y);
+        }
+    }
+
+  m_unlinked.clear();
+  m_unlinked.shrink_to_fit();
+}
+
+const ConfigurationSnapshot::class_info_t *
+ConfigurationSnapshot::find_class(std::string_view name) const noexcept
+{
+  auto i = m_classes_index.find(name);
+  return (i != m_classes_index.end() ? i->second : nullptr);
+}
+
+const ConfigurationSnapshot::object_t *
+ConfigurationSnapshot::get(const std::string& class_name, const std::string& id) const noexcept
+{
+  if (const class_info_t * c = find_class(class_name))
+    {
+      auto i = c->m_objects.find(std::string_view(id));
+
+      if (i != c->m_objects.end())
+        return i->second;
+    }
+
+  return nullptr;
+}
+
+void
+ConfigurationSnapshot::get(const std::string& class_name, std::vector<const object_t *>& objects) const
+{
+  const class_info_t * c = find_class(class_name);
+
+  if (c == nullptr)
+    {
+      std::ostringstream text;
+      text << "cannot find class \'" << class_name << "\' in configuration snapshot";
+      throw dunedaq::conffwk::Generic(ERS_HERE, text.str().c_str());
+    }
+
+  objects.clear();
+  objects.reserve(c->m_objects.size());
+
+  for (const auto& i : c->m_objects)
+    objects.push_back(i.second);
+}
+
+const class_t&
+ConfigurationSnapshot::get_class_info(const std::string& class_name) const
+{
+  if (const class_info_t * c = find_class(class_name))
+    return *c->m_description;
+
+  std::ostringstream text;
+  text << "cannot find class \'" << class_name << "\' in configuration snapshot";
+  throw dunedaq::conffwk::Generic(ERS_HERE, text.str().c_str());
+}
+
+bool
+ConfigurationSnapshot::try_cast(const std::string& target, const std::string& source) const noexcept
+{
+  if (target == source)
+    return true;
+
+  if (const class_info_t * c = find_class(source))
+    for (const auto& s : c->m_superclasses)
+      if (s->m_description->p_name == target)
+        return true;
+
+  return false;
+}
+
+
+const ConfigurationSnapshot::value_t&
+ConfigurationSnapshot::object_t::attribute(const std::string& name) const
+{
+  auto i = m_class->m_attributes.find(std::string_view(name));
+
+  if (i == m_class->m_attributes.end())
+    {
+      std::ostringstream text;
+      text << "object \'" << m_id << '@' << class_name() << "\' has no attribute \'" << name << '\'';
+      throw dunedaq::conffwk::Generic(ERS_HERE, text.str().c_str());
+    }
+
+  return m_values[i->second];
+}
+
+void
+ConfigurationSnapshot::object_t::throw_bad_type(const std::string& name) const
+{
+  std::ostringstream text;
+  text << "the type of value of attribute \'" << name << "\' of object \'" << m_id << '@' << class_name() << "\' differs from the requested one";
+  throw dunedaq::conffwk::Generic(ERS_HERE, text.str().c_str());
+}
+
+void
+ConfigurationSnapshot::object_t::get(const std::string& name, const object_t *& value) const
+{
+  auto i = m_class->m_relationships.find(std::string_view(name));
+
+  if (i == m_class->m_relationships.end())
+    {
+      std::ostringstream text;
+      text << "object \'" << m_id << '@' << class_name() << "\' has no relationship \'" << name << '\'';
+      throw dunedaq::conffwk::Generic(ERS_HERE, text.str().c_str());
+    }
+
+  value = (m_refs[i->second].empty() ? nullptr : m_refs[i->second].front());
+}
+
+void
+ConfigurationSnapshot::object_t::get(const std::string& name, std::vector<const object_t *>& value) const
+{
+  auto i = m_class->m_relationships.find(std::string_view(name));
+
+  if (i == m_class->m_relationships.end())
+    {
+      std::ostringstream text;
+      text << "object \'" << m_id << '@' << class_name() << "\' has no relationship \'" << name << '\'';
+      throw dunedaq::conffwk::Generic(ERS_HERE, text.str().c_str());
+    }
+
+  value = m_refs[i->second];
+}
+
+bool
+ConfigurationSnapshot::object_t::castable(const std::string& name) const noexcept
+{
+  if (class_name() == name)
+    return true;
+
+  for (const auto& s : m_class->m_superclasses)
+    if (s->m_description->p_name == name)
+      return true;
+
+  return false;
+}
+
+} // namespace conffwk
+} // namespace dunedaq
@@ -0,0 +1,1136 @@
+#include <cerrno>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+#include <type_traits>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include "conffwk/ConfigObject.hpp"
+#include "conffwk/DalFactory.hpp"
+#include "conffwk/Errors.hpp"
+#include "conffwk/SnapshotCache.hpp"
+
+namespace dunedaq {
+namespace conffwk {
+
+  // the file starts from magic string, version and byte order marker; the snapshot written by other version or on a host with other byte order is ignored
+
+static const char s_magic[8] = { 'c', 'o', 'n', 'f', 'f', 'w', 'k', 's' };
+static const uint32_t s_version = 1;
+static const uint32_t s_byte_order = 0x01020304;
+
+
+  /**
+   *  The snapshot file layout (all numbers are in host byte order, strings are stored as 32-bits length and characters):
+   *  - header: magic, version, byte order marker
+   *  - database name and files (name, size, hash)
+   *  - included files: database file name and names of files it includes
+   *  - classes: descriptions with inherited properties and direct only
+   *  - objects index: id, class index, file index and offset of object's data relative to the end of the index
+   *  - objects data: values of attributes, indices of referenced objects and of objects referencing this one
+   */
+
+namespace
+{
+  class writer
+  {
+  public:
+
+    template<class T>
+      typename std::enable_if<std::is_arithmetic<T>::value>::type
+      put(T value)
+      {
+        m_data.append(reinterpret_cast<const char *>(&value), sizeof(T));
+      }
+
+    void
+    put(const std::string& value)
+    {
+      put<uint32_t>(value.size());
+      m_data.append(value);
+    }
+
+    void
+    put(const std::vector<bool>& value)
+    {
+      put<uint32_t>(value.size());
+      for (bool x : value)
+        put<uint8_t>(x);
+    }
+
+    void
+    put(const std::vector<std::string>& value)
+    {
+      put<uint32_t>(value.size());
+      for (const auto& x : value)
+        put(x);
+    }
+
+    template<class T>
+      void
+      put(const std::vector<T>& value)
+      {
+        put<uint32_t>(value.size());
+
+        if (!value.empty())
+          m_data.append(reinterpret_cast<const char *>(value.data()), value.size() * sizeof(T));
+      }
+
+    void
+    put(const class_t& c)
+    {
+      put(c.p_name);
+      put(c.p_description);
+      put<uint8_t>(c.p_abstract);
+      put(c.p_superclasses);
+      put(c.p_subclasses);
+
+      put<uint32_t>(c.p_attributes.size());
+      for (const auto& a : c.p_attributes)
+        {
+          put(a.p_name);
+          put<uint32_t>(a.p_type);
+          put(a.p_range);
+          put<uint32_t>(a.p_int_format);
+          put<uint8_t>(a.p_is_not_null);
+          put<uint8_t>(a.p_is_multi_value);
+          put(a.p_default_value);
+          put(a.p_description);
+        }
+
+      put<uint32_t>(c.p_relationships.size());
+      for (const auto& r : c.p_relationships)
+        {
+          put(r.p_name);
+          put(r.p_type);
+          put<uint32_t>(r.p_cardinality);
+          put<uint8_t>(r.p_is_aggregation);
+          put(r.p_description);
+        }
+    }
+
+    void
+    put(const attribute_value_t& value)
+    {
+      put<uint8_t>(value.index());
+      std::visit([this](const auto& x) { put(x); }, value);
+    }
+
+    std::string m_data;
+  };
+
+
+  class reader
+  {
+  public:
+
+    reader(const std::string& file_name, const char * data, std::size_t size, std::size_t pos = 0) noexcept :
+      m_file_name(file_name), m_data(data), m_size(size), m_pos(pos)
+    {
+      ;
+    }
+
+    [[noreturn]] void
+    throw_corrupted() const
+    {
+      std::ostringstream text;
+      text << "snapshot file \'" << m_file_name << "\' is corrupted (bad data at offset " << m_pos << ')';
+      throw dunedaq::conffwk::Generic(ERS_HERE, text.str().c_str());
+    }
+
+    const char *
+    take(std::size_t len)
+    {
+      if (len > m_size - m_pos)
+        throw_corrupted();
+
+      const char * p = m_data + m_pos;
+      m_pos += len;
+      return p;
+    }
+
+    template<class T>
+      typename std::enable_if<std::is_arithmetic<T>::value>::type
+      get(T& value)
+      {
+        std::memcpy(&value, take(sizeof(T)), sizeof(T));
+      }
+
+    template<class T>
+      T
+      get()
+      {
+        T value;
+        get(value);
+        return value;
+      }
+
+    void
+    get(bool& value)
+    {
+      value = (get<uint8_t>() != 0);
+    }
+
+    void
+    get(std::string& value)
+    {
+      const uint32_t len = get<uint32_t>();
+      value.assign(take(len), len);
+    }
+
+    void
+    get(std::vector<bool>& value)
+    {
+      value.resize(get_size());
+      for (std::size_t i = 0; i < value.size(); ++i)
+        value[i] = (get<uint8_t>() != 0);
+    }
+
+    void
+    get(std::vector<std::string>& value)
+    {
+      value.resize(get_size());
+      for (auto& x : value)
+        get(x);
+    }
+
+    template<class T>
+      void
+      get(std::vector<T>& value)
+      {
+        const uint32_t len = get<uint32_t>();
+
+        if (len > (m_size - m_pos) / sizeof(T))
+          throw_corrupted();
+
+        value.resize(len);
+
+        if (len)
+          std::memcpy(value.data(), take(len * sizeof(T)), len * sizeof(T));
+      }
+
+    template<std::size_t I = 0>
+      void
+      get(std::size_t index, attribute_value_t& value)
+      {
+        if constexpr (I < std::variant_size<attribute_value_t>::value)
+          {
+            if (index == I)
+              get(value.emplace<I>());
+            else
+              get<I + 1>(index, value);
+          }
+        else
+          throw_corrupted();
+      }
+
+    void
+    get(attribute_value_t& value)
+    {
+      get(get<uint8_t>(), value);
+    }
+
+    std::unique_ptr<class_t>
+    get_class()
+    {
+      std::string name, description;
+      get(name);
+      get(description);
+      std::unique_ptr<class_t> c(new class_t(name, description, get<bool>()));
+
+      get(const_cast<std::vector<std::string>&>(c->p_superclasses));
+      get(const_cast<std::vector<std::string>&>(c->p_subclasses));
+
+      std::vector<attribute_t>& attributes(const_cast<std::vector<attribute_t>&>(c->p_attributes));
+      attributes.resize(get_size());
+
+      for (auto& a : attributes)
+        {
+          get(a.p_name);
+          a.p_type = static_cast<type_t>(get<uint32_t>());
+          get(a.p_range);
+          a.p_int_format = static_cast<int_format_t>(get<uint32_t>());
+          get(a.p_is_not_null);
+          get(a.p_is_multi_value);
+          get(a.p_default_value);
+          get(a.p_description);
+        }
+
+      std::vector<relationship_t>& relationships(const_cast<std::vector<relationship_t>&>(c->p_relationships));
+      relationships.resize(get_size());
+
+      for (auto& r : relationships)
+        {
+          get(r.p_name);
+          get(r.p_type);
+          r.p_cardinality = static_cast<cardinality_t>(get<uint32_t>());
+          get(r.p_is_aggregation);
+          get(r.p_description);
+        }
+
+      return c;
+    }
+
+      // get number of items; each item takes at least one byte, so a bigger number means corrupted file
+
+    uint32_t
+    get_size()
+    {
+      const uint32_t len = get<uint32_t>();
+
+      if (len > m_size - m_pos)
+        throw_corrupted();
+
+      return len;
+    }
+
+    std::size_t pos() const noexcept { return m_pos; }
+
+  private:
+
+    const std::string& m_file_name;
+    const char * m_data;
+    std::size_t m_size;
+    std::size_t m_pos;
+  };
+}
+
+
+bool
+SnapshotCacheImpl::read_file_info(file_t& file) noexcept
+{
+  std::ifstream f(file.p_name, std::ios::binary);
+
+  if (!f)
+    return false;
+
+  // FNV-1a 64-bits hash
+
+  uint64_t hash = 14695981039346656037ULL;
+  uint64_t size = 0;
+  char buf[65536];
+
+  while (f)
+    {
+      f.read(buf, sizeof(buf));
+
+      const std::streamsize len = f.gcount();
+
+      for (std::streamsize i = 0; i < len; ++i)
+        {
+          hash ^= static_cast<unsigned char>(buf[i]);
+          hash *= 1099511628211ULL;
+        }
+
+      size += len;
+    }
+
+  if (f.bad())
+    return false;
+
+  file.p_size = size;
+  file.p_hash = hash;
+
+  return true;
+}
+
+
+void
+SnapshotCacheImpl::write(const std::string& file_name, const contents_t& contents)
+{
+  const std::string& db_name(contents.p_db_name);
+
+  // index classes and objects
+
+  std::map<std::string, uint32_t> classes, files;
+  std::map<std::pair<std::string, std::string>, uint32_t> objects;
+
+  for (const auto& c : contents.p_classes)
+    classes.emplace(c.first->p_name, classes.size());
+
+  for (const auto& f : contents.p_files)
+    files.emplace(f.p_name, files.size());
+
+  for (const auto& o : contents.p_objects)
+    objects.emplace(std::make_pair(o.p_class_name, o.p_id), objects.size());
+
+  // objects referencing each object (index of object and of its relationship)
+
+  std::vector<std::vector<std::vector<uint32_t>>> refs(contents.p_objects.size());
+  std::vector<std::vector<std::pair<uint32_t, uint32_t>>> referenced_by(contents.p_objects.size());
+
+  for (uint32_t i = 0; i < contents.p_objects.size(); ++i)
+    {
+      const object_t& o(contents.p_objects[i]);
+      refs[i].resize(o.p_refs.size());
+
+      for (uint32_t j = 0; j < o.p_refs.size(); ++j)
+        for (const auto& r : o.p_refs[j])
+          {
+            auto x = objects.find(r);
+
+            if (x == objects.end())
+              {
+                std::ostringstream text;
+                text << "object \'" << o.p_id << '@' << o.p_class_name << "\' references object \'" << r.second << '@' << r.first << "\', which is not stored";
+                throw dunedaq::conffwk::Generic(ERS_HERE, text.str().c_str());
+              }
+
+            refs[i][j].push_back(x->second);
+
+            std::vector<std::pair<uint32_t, uint32_t>>& v(referenced_by[x->second]);
+
+            if (v.empty() || v.back() != std::make_pair(i, j))
+              v.emplace_back(i, j);
+          }
+    }
+
+  writer head, body;
+
+  head.m_data.append(s_magic, sizeof(s_magic));
+  head.put(s_version);
+  head.put(s_byte_order);
+
+  head.put(db_name);
+  head.put<uint32_t>(contents.p_files.size());
+  for (const auto& f : contents.p_files)
+    {
+      head.put(f.p_name);
+      head.put(f.p_size);
+      head.put(f.p_hash);
+    }
+
+  head.put<uint32_t>(contents.p_includes.size());
+  for (const auto& i : contents.p_includes)
+    {
+      head.put(i.first);
+      head.put(std::vector<std::string>(i.second.begin(), i.second.end()));
+    }
+
+  head.put<uint32_t>(contents.p_classes.size());
+  for (const auto& c : contents.p_classes)
+    {
+      head.put(*c.first);
+      head.put(*c.second);
+    }
+
+  head.put<uint32_t>(contents.p_objects.size());
+  for (uint32_t i = 0; i < contents.p_objects.size(); ++i)
+    {
+      const object_t& o(contents.p_objects[i]);
+
+      auto c = classes.find(o.p_class_name);
+      auto f = files.find(o.p_file);
+
+      if (c == classes.end() || f == files.end())
+        {
+          std::ostringstream text;
+          text << "cannot find " << (c == classes.end() ? "class" : "file") << " of object \'" << o.p_id << '@' << o.p_class_name << '\'';
+          throw dunedaq::conffwk::Generic(ERS_HERE, text.str().c_str());
+        }
+
+      head.put(o.p_id);
+      head.put(c->second);
+      head.put(f->second);
+      head.put<uint64_t>(body.m_data.size());
+
+      body.put<uint32_t>(o.p_values.size());
+      for (const auto& v : o.p_values)
+        body.put(v);
+
+      body.put<uint32_t>(refs[i].size());
+      for (const auto& r : refs[i])
+        body.put(r);
+
+      body.put<uint32_t>(referenced_by[i].size());
+      for (const auto& r : referenced_by[i])
+        {
+          body.put(r.first);
+          body.put(r.second);
+        }
+    }
+
+  // write temporary file and rename it, so concurrent processes never read partially written snapshot
+
+  const std::string tmp_name(file_name + '.' + std::to_string(::getpid()));
+
+    {
+      std::ofstream f(tmp_name, std::ios::binary);
+
+      f.write(head.m_data.data(), head.m_data.size());
+      f.write(body.m_data.data(), body.m_data.size());
+      f.close();
+
+      if (!f)
+        {
+          std::remove(tmp_name.c_str());
+          std::ostringstream text;
+          text << "cannot write snapshot file \'" << tmp_name << '\'';
+          throw dunedaq::conffwk::Generic(ERS_HERE, text.str().c_str());
+        }
+    }
+
+  if (std::rename(tmp_name.c_str(), file_name.c_str()) != 0)
+    {
+      std::ostringstream text;
+      text << "cannot rename \'" << tmp_name << "\' to snapshot file \'" << file_name << "\': " << std::strerror(errno);
+      std::remove(tmp_name.c_str());
+      throw dunedaq::conffwk::Generic(ERS_HERE, text.str().c_str());
+    }
+
+  TLOG_DEBUG(1) << "wrote snapshot of database \'" << db_name << "\' (" << contents.p_objects.size() << " objects of " << contents.p_classes.size() << " classes, " << (head.m_data.size() + body.m_data.size()) << " bytes) to file \'" << file_name << '\'';
+}
+
+
+SnapshotCacheImpl *
+SnapshotCacheImpl::open(const std::string& file_name, const std::string& db_name) noexcept
+{
+  int fd = ::open(file_name.c_str(), O_RDONLY);
+
+  if (fd < 0)
+    {
+      TLOG_DEBUG(1) << "there is no snapshot file \'" << file_name << '\'';
+      return nullptr;
+    }
+
+  struct stat st;
+  void * data = MAP_FAILED;
+
+  if (::fstat(fd, &st) == 0 && st.st_size > 0)
+    data = ::mmap(nullptr, st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+
+  ::close(fd);
+
+  if (data == MAP_FAILED)
+    {
+      TLOG_DEBUG(1) << "cannot map snapshot file \'" << file_name << "\': " << std::strerror(errno);
+      return nullptr;
+    }
+
+  std::unique_ptr<SnapshotCacheImpl> impl(new SnapshotCacheImpl(file_name, db_name, static_cast<const char *>(data), st.st_size));
+
+  try
+    {
+      impl->read_index();
+      return impl.release();
+    }
+  catch (const std::exception& ex)
+    {
+      TLOG_DEBUG(1) << "cannot use snapshot file \'" << file_name << "\': " << ex.what();
+      return nullptr;
+    }
+}
+
+
+SnapshotCacheImpl::SnapshotCacheImpl(const std::string& file_name, const std::string& db_name, const char * data, std::size_t size) noexcept :
+  m_file_name(file_name), m_db_name(db_name), m_data(data), m_size(size), m_loaded(true), p_number_of_decoded_objects(0)
+{
+  ;
+}
+
+SnapshotCacheImpl::~SnapshotCacheImpl() noexcept
+{
+  clean();
+  ::munmap(const_cast<char *>(m_data), m_size);
+}
+
+
+void
+SnapshotCacheImpl::read_index()
+{
+  reader in(m_file_name, m_data, m_size);
+
+  if (std::memcmp(in.take(sizeof(s_magic)), s_magic, sizeof(s_magic)) != 0 || in.get<uint32_t>() != s_version || in.get<uint32_t>() != s_byte_order)
+    throw dunedaq::conffwk::Generic(ERS_HERE, "unsupported format");
+
+  std::string db_name;
+  in.get(db_name);
+
+  if (db_name != m_db_name)
+    {
+      std::ostringstream text;
+      text << "the snapshot contains other database \'" << db_name << '\'';
+      throw dunedaq::conffwk::Generic(ERS_HERE, text.str().c_str());
+    }
+
+  // check the snapshot is not stale
+
+  m_files.resize(in.get_size());
+
+  for (auto& name : m_files)
+    {
+      file_t stored, actual;
+      in.get(stored.p_name);
+      in.get(stored.p_size);
+      in.get(stored.p_hash);
+
+      name = actual.p_name = stored.p_name;
+
+      if (!read_file_info(actual) || actual.p_size != stored.p_size || actual.p_hash != stored.p_hash)
+        {
+          std::ostringstream text;
+          text << "the snapshot is stale: file \'" << stored.p_name << "\' was modified or removed";
+          throw dunedaq::conffwk::Generic(ERS_HERE, text.str().c_str());
+        }
+    }
+
+  for (uint32_t n = in.get_size(); n > 0; --n)
+    {
+      std::string name;
+      std::vector<std::string> includes;
+      in.get(name);
+      in.get(includes);
+      m_includes[name].assign(includes.begin(), includes.end());
+    }
+
+  m_classes.resize(in.get_size());
+
+  for (auto& c : m_classes)
+    {
+      c.reset(new class_info_t());
+      c->m_description = in.get_class();
+      c->m_direct_description = in.get_class();
+
+      const class_t& d(*c->m_description);
+
+      for (uint32_t i = 0; i < d.p_attributes.size(); ++i)
+        c->m_attributes.try_emplace(std::string_view(d.p_attributes[i].p_name), i);
+
+      for (uint32_t i = 0; i < d.p_relationships.size(); ++i)
+        c->m_relationships.try_emplace(std::string_view(d.p_relationships[i].p_name), i);
+
+      m_classes_index.try_emplace(std::string_view(d.p_name), c.get());
+    }
+
+  for (auto& c : m_classes)
+    for (const auto& s : c->m_description->p_subclasses)
+      if (const class_info_t * x = find_class(s))
+        c->m_subclasses.push_back(x);
+
+  // the objects index refers IDs stored by the vector, so it is never reallocated
+
+  const uint32_t num_of_objects = in.get_size();
+
+  m_objects.resize(num_of_objects);
+
+  for (uint32_t i = 0; i < num_of_objects; ++i)
+    {
+      entry_t& x(m_objects[i]);
+
+      in.get(x.m_id);
+
+      const uint32_t class_idx = in.get<uint32_t>();
+      in.get(x.m_file);
+      in.get(x.m_offset);
+
+      if (class_idx >= m_classes.size() || x.m_file >= m_files.size())
+        in.throw_corrupted();
+
+      class_info_t * c = m_classes[class_idx].get();
+      x.m_class = c;
+      c->m_objects.try_emplace(std::string_view(x.m_id), i);
+    }
+
+  // the offsets of objects data are relative to the end of the index
+
+  for (auto& x : m_objects)
+    {
+      x.m_offset += in.pos();
+
+      if (x.m_offset >= m_size)
+        in.throw_corrupted();
+    }
+
+  TLOG_DEBUG(1) << "opened snapshot file \'" << m_file_name << "\' of database \'" << m_db_name << "\' (" << m_objects.size() << " objects of " << m_classes.size() << " classes)";
+}
+
+
+void
+SnapshotCacheImpl::decode(uint32_t idx, object_data_t& data) const
+{
+  const entry_t& x(m_objects[idx]);
+  reader in(m_file_name, m_data, m_size, x.m_offset);
+
+  data.m_entry = &x;
+
+  data.m_values.resize(in.get_size());
+
+  if (data.m_values.size() != x.m_class->m_description->p_attributes.size())
+    in.throw_corrupted();
+
+  for (auto& v : data.m_values)
+    in.get(v);
+
+  data.m_refs.resize(in.get_size());
+
+  if (data.m_refs.size() != x.m_class->m_description->p_relationships.size())
+    in.throw_corrupted();
+
+  for (auto& r : data.m_refs)
+    {
+      in.get(r);
+
+      for (auto i : r)
+        if (i >= m_objects.size())
+          in.throw_corrupted();
+    }
+
+  data.m_referenced_by.resize(in.get_size());
+
+  for (auto& r : data.m_referenced_by)
+    {
+      in.get(r.first);
+      in.get(r.second);
+
+      if (r.first >= m_objects.size() || r.second >= m_objects[r.first].m_class->m_description->p_relationships.size())
+        in.throw_corrupted();
+    }
+}
+
+
+const SnapshotCacheImpl::class_info_t *
+SnapshotCacheImpl::find_class(const std::string& name) const noexcept
+{
+  auto i = m_classes_index.find(std::string_view(name));
+  return (i != m_classes_index.end() ? i->second : nullptr);
+}
+
+const SnapshotCacheImpl::entry_t *
+SnapshotCacheImpl::find_object(const std::string& class_name, const std::string& id) const noexcept
+{
+  if (const class_info_t * c = find_class(class_name))
+    {
+      auto i = c->m_objects.find(std::string_view(id));
+
+      if (i != c->m_objects.end())
+        return &m_objects[i->second];
+
+      for (const auto& s : c->m_subclasses)
+        {
+          auto j = s->m_objects.find(std::string_view(id));
+
+          if (j != s->m_objects.end())
+            return &m_objects[j->second];
+        }
+    }
+
+  return nullptr;
+}
+
+void
+SnapshotCacheImpl::get_object(uint32_t idx, ConfigObject& object)
+{
+  const entry_t& x(m_objects[idx]);
+  const std::string& class_name(x.m_class->m_description->p_name);
+
+  std::lock_guard<std::mutex> scoped_lock(m_objects_mutex);
+
+  if (ConfigObjectImpl * obj = get_impl_object(class_name, x.m_id))
+    {
+      object = obj;
+      return;
+    }
+
+  // decode before insertion, since the insert_object() does not throw
+
+  object_data_t data;
+  decode(idx, data);
+
+  object = insert_object<SnapshotCacheObject>(data, x.m_id, class_name);
+  p_number_of_decoded_objects++;
+}
+
+void
+SnapshotCacheImpl::throw_read_only(const char * action) const
+{
+  std::ostringstream text;
+  text << "cannot " << action << ": database \'" << m_db_name << "\' is read from snapshot file \'" << m_file_name << "\' (the Configuration replaces it by implementation plug-in)";
+  throw dunedaq::conffwk::Generic(ERS_HERE, text.str().c_str());
+}
+
+
+void
+SnapshotCacheImpl::open_db(const std::string& db_name)
+{
+  if (db_name != m_db_name)
+    {
+      std::ostringstream text;
+      text << "cannot open database \'" << db_name << "\': snapshot file \'" << m_file_name << "\' contains database \'" << m_db_name << '\'';
+      throw dunedaq::conffwk::Generic(ERS_HERE, text.str().c_str());
+    }
+
+  m_loaded = true;
+}
+
+void
+SnapshotCacheImpl::close_db()
+{
+  clean();
+  m_loaded = false;
+}
+
+void
+SnapshotCacheImpl::create(const std::string&, const std::list<std::string>&)
+{
+  throw_read_only("create database");
+}
+
+bool
+SnapshotCacheImpl::is_writable(const std::string& db_name)
+{
+  // the database is modified by implementation plug-in replacing the snapshot (see Configuration::leave_snapshot_cache())
+
+  for (const auto& f : m_files)
+    if (f == db_name || (f.size() > db_name.size() && f.compare(f.size() - db_name.size(), db_name.size(), db_name) == 0 && f[f.size() - db_name.size() - 1] == '/'))
+      return (::access(f.c_str(), W_OK) == 0);
+
+  return false;
+}
+
+void
+SnapshotCacheImpl::add_include(const std::string&, const std::string&)
+{
+  throw_read_only("add include");
+}
+
+void
+SnapshotCacheImpl::remove_include(const std::string&, const std::string&)
+{
+  throw_read_only("remove include");
+}
+
+void
+SnapshotCacheImpl::get_includes(const std::string& db_name, std::list<std::string>& includes) const
+{
+  auto i = m_includes.find(db_name);
+
+  if (i == m_includes.end())
+    throw dunedaq::conffwk::NotFound(ERS_HERE, "database file", db_name.c_str());
+
+  includes = i->second;
+}
+
+void
+SnapshotCacheImpl::get_updated_dbs(std::list<std::string>& dbs) const
+{
+  dbs.clear();
+}
+
+void
+SnapshotCacheImpl::set_commit_credentials(const std::string&, const std::string&)
+{
+  throw_read_only("set commit credentials");
+}
+
+void
+SnapshotCacheImpl::commit(const std::string&)
+{
+  throw_read_only("commit");
+}
+
+void
+SnapshotCacheImpl::abort()
+{
+  ;
+}
+
+void
+SnapshotCacheImpl::prefetch_all_data()
+{
+  for (uint32_t i = 0; i < m_objects.size(); ++i)
+    {
+      ConfigObject obj;
+      get_object(i, obj);
+    }
+}
+
+std::vector<dunedaq::conffwk::Version>
+SnapshotCacheImpl::get_changes()
+{
+  return {};
+}
+
+std::vector<dunedaq::conffwk::Version>
+SnapshotCacheImpl::get_versions(const std::string&, const std::string&, dunedaq::conffwk::Version::QueryType, bool)
+{
+  return {};
+}
+
+void
+SnapshotCacheImpl::get(const std::string& class_name, const std::string& id, ConfigObject& object, unsigned long, const std::vector<std::string> *)
+{
+  if (const entry_t * x = find_object(class_name, id))
+    {
+      get_object(x - m_objects.data(), object);
+    }
+  else
+    {
+      const std::string name(id + '@' + class_name);
+      throw dunedaq::conffwk::NotFound(ERS_HERE, "object", name.c_str());
+    }
+}
+
+void
+SnapshotCacheImpl::get(const std::string& class_name, std::vector<ConfigObject>& objects, const std::string& query, unsigned long, const std::vector<std::string> *)
+{
+  if (!query.empty())
+    {
+      std::ostringstream text;
+      text << "query \'" << query << "\' is not supported by snapshot file \'" << m_file_name << '\'';
+      throw dunedaq::conffwk::Generic(ERS_HERE, text.str().c_str());
+    }
+
+  const class_info_t * c = find_class(class_name);
+
+  if (c == nullptr)
+    throw dunedaq::conffwk::NotFound(ERS_HERE, "class", class_name.c_str());
+
+  objects.clear();
+
+  auto add = [&](const class_info_t * x)
+    {
+      for (const auto& i : x->m_objects)
+        get_object(i.second, objects.emplace_back());
+    };
+
+  add(c);
+
+  for (const auto& s : c->m_subclasses)
+    add(s);
+}
+
+void
+SnapshotCacheImpl::get(const ConfigObject&, const std::string& query, std::vector<ConfigObject>&, unsigned long, const std::vector<std::string> *)
+{
+  std::ostringstream text;
+  text << "path query \'" << query << "\' is not supported by snapshot file \'" << m_file_name << '\'';
+  throw dunedaq::conffwk::Generic(ERS_HERE, text.str().c_str());
+}
+
+bool
+SnapshotCacheImpl::test_object(const std::string& class_name, const std::string& id, unsigned long, const std::vector<std::string> *)
+{
+  return (find_object(class_name, id) != nullptr);
+}
+
+void
+SnapshotCacheImpl::create(const std::string&, const std::string&, const std::string&, ConfigObject&)
+{
+  throw_read_only("create object");
+}
+
+void
+SnapshotCacheImpl::create(const ConfigObject&, const std::string&, const std::string&, ConfigObject&)
+{
+  throw_read_only("create object");
+}
+
+void
+SnapshotCacheImpl::destroy(ConfigObject&)
+{
+  throw_read_only("destroy object");
+}
+
+dunedaq::conffwk::class_t *
+SnapshotCacheImpl::get(const std::string& class_name, bool direct_only)
+{
+  const class_info_t * c = find_class(class_name);
+
+  if (c == nullptr)
+    throw dunedaq::conffwk::NotFound(ERS_HERE, "class", class_name.c_str());
+
+  return new class_t(direct_only ? *c->m_direct_description : *c->m_description);
+}
+
+void
+SnapshotCacheImpl::get_superclasses(conffwk::fmap<conffwk::fset>& schema)
+{
+  schema.clear();
+
+  for (const auto& c : m_classes)
+    {
+      conffwk::fset& s(schema[&DalFactory::instance().get_known_class_name_ref(c->m_description->p_name)]);
+
+      for (const auto& x : c->m_description->p_superclasses)
+        s.insert(&DalFactory::instance().get_known_class_name_ref(x));
+    }
+}
+
+void
+SnapshotCacheImpl::subscribe(const std::set<std::string>&, const std::map< std::string, std::set<std::string> >&, notify, pre_notify)
+{
+  throw_read_only("subscribe");
+}
+
+void
+SnapshotCacheImpl::unsubscribe()
+{
+  ;
+}
+
+void
+SnapshotCacheImpl::print_profiling_info() noexcept
+{
+  std::cout <<
+    "Configuration snapshot cache profiler report:\n"
+    "  snapshot file: \'" << m_file_name << "\' (" << m_size << " bytes)\n"
+    "  number of objects: " << m_objects.size() << "\n"
+    "  number of decoded objects: " << p_number_of_decoded_objects << std::endl;
+}
+
+
+SnapshotCacheObject::SnapshotCacheObject(SnapshotCacheImpl::object_data_t& data, ConfigurationImpl * impl) noexcept :
+  ConfigObjectImpl(impl, data.m_entry->m_id), m_data(std::move(data))
+{
+  ;
+}
+
+void
+SnapshotCacheObject::set(SnapshotCacheImpl::object_data_t& data) noexcept
+{
+  m_data = std::move(data);
+}
+
+const std::string
+SnapshotCacheObject::contained_in() const
+{
+  return impl().m_files[m_data.m_entry->m_file];
+}
+
+const attribute_value_t&
+SnapshotCacheObject::attribute(const std::string& name) const
+{
+  const auto& attributes(m_data.m_entry->m_class->m_attributes);
+  auto i = attributes.find(std::string_view(name));
+
+  if (i == attributes.end())
+    {
+      std::ostringstream text;
+      text << "object \'" << m_data.m_entry->m_id << '@' << *m_class_name << "\' has no attribute \'" << name << '\'';
+      throw dunedaq::conffwk::Generic(ERS_HERE, text.str().c_str());
+    }
+
+  return m_data.m_values[i->second];
+}
+
+std::size_t
+SnapshotCacheObject::relationship(const std::string& name) const
+{
+  const auto& relationships(m_data.m_entry->m_class->m_relationships);
+  auto i = relationships.find(std::string_view(name));
+
+  if (i == relationships.end())
+    {
+      std::ostringstream text;
+      text << "object \'" << m_data.m_entry->m_id << '@' << *m_class_name << "\' has no relationship \'" << name << '\'';
+      throw dunedaq::conffwk::Generic(ERS_HERE, text.str().c_str());
+    }
+
+  return i->second;
+}
+
+void
+SnapshotCacheObject::throw_bad_type(const std::string& name) const
+{
+  std::ostringstream text;
+  text << "the type of value of attribute \'" << name << "\' of object \'" << m_data.m_entry->m_id << '@' << *m_class_name << "\' differs from the requested one";
+  throw dunedaq::conffwk::Generic(ERS_HERE, text.str().c_str());
+}
+
+void
+SnapshotCacheObject::throw_read_only(const std::string& name) const
+{
+  std::ostringstream text;
+  text << "cannot modify \'" << name << "\' of object \'" << m_data.m_entry->m_id << '@' << *m_class_name << "\' read from snapshot file";
+  throw dunedaq::conffwk::Generic(ERS_HERE, text.str().c_str());
+}
+
+void
+SnapshotCacheObject::get(const std::string& name, ConfigObject& value)
+{
+  const std::vector<uint32_t>& refs(m_data.m_refs[relationship(name)]);
+
+  if (refs.empty())
+    value = nullptr;
+  else
+    impl().get_object(refs.front(), value);
+}
+
+void
+SnapshotCacheObject::get(const std::string& name, std::vector<ConfigObject>& value)
+{
+  const std::vector<uint32_t>& refs(m_data.m_refs[relationship(name)]);
+
+  value.clear();
+  value.reserve(refs.size());
+
+  for (auto i : refs)
+    impl().get_object(i, value.emplace_back());
+}
+
+bool
+SnapshotCacheObject::rel(const std::string& name, std::vector<ConfigObject>& value)
+{
+  if (m_data.m_entry->m_class->m_relationships.find(std::string_view(name)) == m_data.m_entry->m_class->m_relationships.end())
+    return false;
+
+  get(name, value);
+  return true;
+}
+
+void
+SnapshotCacheObject::referenced_by(std::vector<ConfigObject>& value, const std::string& association, bool check_composite_only, unsigned long, const std::vector<std::string> *) const
+{
+  value.clear();
+
+  for (const auto& r : m_data.m_referenced_by)
+    {
+      const relationship_t& x(impl().m_objects[r.first].m_class->m_description->p_relationships[r.second]);
+
+      if ((association == "*" || x.p_name == association) && (!check_composite_only || x.p_is_aggregation))
+        {
+          // an object can reference this one by several relationships
+          ConfigObject obj;
+          impl().get_object(r.first, obj);
+
+          if (value.empty() || !(value.back() == obj))
+            value.push_back(obj);
+        }
+    }
+}
+
+void
+SnapshotCacheObject::get_batch(const class_t& description, std::vector<attribute_value_t>& values)
+{
+  if (description.p_name == m_data.m_entry->m_class->m_description->p_name)
+    values = m_data.m_values;
+  else
+    ConfigObjectImpl::get_batch(description, values);
+}
+
+void
+SnapshotCacheObject::move(const std::string& at)
+{
+  throw_read_only("file " + at);
+}
+
+void
+SnapshotCacheObject::rename(const std::string& new_id)
+{
+  throw_read_only("ID " + new_id);
+}
+
+void
+SnapshotCacheObject::reset()
+{
+  m_state = dunedaq::conffwk::Valid;
+}
+
+} // namespace conffwk
+} // namespace dunedaq
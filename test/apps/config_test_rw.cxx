@@ -2,6 +2,7 @@
 #include <stdint.h>
 
 #include <iostream>
+#include <set>
 #include <string>
 
 #include "conffwk/Configuration.hpp"
@@ -70,6 +71,99 @@ template<class T> void check_value(ConfigObject& o, const std::string& name, T v
   }
 }
 
+template<class T> void check_column(::Configuration& db, const std::string& class_name, const std::string& name)
+{
+  std::vector<T> values;
+  std::vector<ConfigObject> objs, all;
+
+  db.get_column(class_name, name, values, &objs);
+  db.get(class_name, all);
+
+  std::cout << "TEST column " << name << " of " << objs.size() << " objects of class " << class_name << ": ";
+
+  if(values.size() != objs.size() || objs.size() != all.size()) {
+    std::cout << "FAILED (read " << values.size() << " values of " << objs.size() << " objects, expected " << all.size() << ")\n";
+    return;
+  }
+
+  for(unsigned int i = 0; i < objs.size(); ++i) {
+    T v;
+    objs[i].get(name, v);
+    if(v != values[i]) {
+      std::cout << "FAILED (value of object " << objs[i] << " differs)\n";
+      return;
+    }
+  }
+
+  std::cout << "OK\n";
+}
+
+template<class T> void check_find_by(::Configuration& db, const std::string& class_name, const std::string& name, const T& value, const char * action)
+{
+  std::set<std::string> expected, found;
+  std::vector<ConfigObject> objs;
+
+  db.get(class_name, objs);
+
+  for(auto& o : objs) {
+    T v;
+    o.get(name, v);
+    if(v == value) expected.insert(o.full_name());
+  }
+
+  objs.clear();
+  db.find_by(class_name, name, value, objs);
+
+  for(auto& o : objs) found.insert(o.full_name());
+
+  std::cout << "TEST find_by " << name << " of class " << class_name << " after " << action << ": "
+            << (found == expected ? "OK" : "FAILED") << " (found " << found.size() << " objects, full scan found " << expected.size() << ")\n";
+}
+
+void check_referenced_by(::Configuration& db, ConfigObject& o, const char * action)
+{
+  std::set<std::string> expected, found;
+  std::vector<ConfigObject> objs;
+
+  db.get("Dummy", objs);  // all objects of test are of Dummy class and of its subclasses
+
+  for(auto& x : objs) {
+    for(const auto& r : db.get_class_info(x.class_name()).p_relationships) {
+      std::vector<ConfigObject> values;
+
+      if(r.p_cardinality == zero_or_many || r.p_cardinality == one_or_many) {
+        x.get(r.p_name, values);
+      }
+      else {
+        ConfigObject v;
+        x.get(r.p_name, v);
+        if(!v.is_null()) values.push_back(v);
+      }
+
+      for(auto& v : values) {
+        if(v == o) expected.insert(x.full_name());
+      }
+    }
+  }
+
+  objs.clear();
+  o.referenced_by(objs, "*", false);
+
+  for(auto& x : objs) found.insert(x.full_name());
+
+  std::cout << "TEST referenced_by of object " << o << " after " << action << ": "
+            << (found == expected ? "OK" : "FAILED") << " (found " << found.size() << " objects, full scan found " << expected.size() << ")\n";
+}
+
+void check_indices(::Configuration& db, ConfigObject& o1, ConfigObject& o3, int32_t value, const char * action)
+{
+  check_find_by<int32_t>(db, "Dummy", "sint32", 0, action);
+  check_find_by<int32_t>(db, "Dummy", "sint32", value, action);
+  check_find_by<std::string>(db, "Second", "string", "", action);
+  check_referenced_by(db, o1, action);
+  check_referenced_by(db, o3, action);
+}
+
 void check_object(ConfigObject& o, const std::string& name, ConfigObject * o1)
 {
   ConfigObject o2;
@@ -238,6 +332,15 @@ int main(int argc, char *argv[])
     check_value(o6, "bool", false);
 
 
+       // the indices are checked against full scan after each modification
+
+    db.create_index("Dummy", "sint32");
+    db.create_index("Second", "string");
+    db.set_references_index(true);
+
+    check_indices(db, o1, o3, 0, "create");
+
+
     bool        bool_value   (true);
     int8_t      int8_value   (0x7F);
     uint8_t     uint8_value  (0xFF);
@@ -348,6 +451,14 @@ int main(int argc, char *argv[])
     check_value(o1, "enum_vector", enum_values);
     check_value(o1, "classref_vector", class_values);
 
+    check_column<bool>(db, "Dummy", "bool");
+    check_column<int32_t>(db, "Dummy", "sint32");
+    check_column<std::string>(db, "Dummy", "string");
+    check_column<std::vector<double>>(db, "Dummy", "double_vector");
+    check_column<std::string>(db, "Second", "enum");
+
+    check_indices(db, o1, o3, int32_value, "set");
+
     check_objects(o3, "Dummy", vec4);
     check_object(o3, "Another", &o1);
     check_objects(o4, "Dummy", vec4);
@@ -432,6 +543,8 @@ int main(int argc, char *argv[])
     db.add_include(data_name, f1);
     db.add_include(data_name, f2);
 
+    check_indices(db, o1, o3, int32_value, "create in included files");
+
     db.commit("test application (conffwk/test/conffwk_test_rw.cpp): create 6 nested files");
 
     std::cout << "\n\nTEST VALIDITY OF OBJECTS AFTER REMOVAL OF INCLUDES: Removing include \"" << f1 << "\"\n\n";
@@ -440,6 +553,8 @@ int main(int argc, char *argv[])
 
     const char * removed_objects_by_include[] = {"f1-1", "f1-2", "f11-1", "f11-2"}; // these objects have to be removed (note, f12 is still included by f2)
 
+    check_indices(db, o1, o3, int32_value, "remove include");
+
     for(int i = 0; i < 12; ++i) {
       std::cout << "TEST object " << data[i].id << " existence after removal of includes: ";
       bool state(false);
@@ -477,6 +592,8 @@ int main(int argc, char *argv[])
 
     std::cout << "TEST deleted object " << o5.UID() << " existence: " << (o5.is_deleted() ? "OK (is_deleted returns TRUE)" : "FAILED (is_deleted returns FALSE)") << std::endl;
 
+    check_indices(db, o1, o3, int32_value, "destroy");
+
     check_file_path(o1, data_name);
     check_file_path(o3, data_name);
     check_file_path(o6, data_name);
@@ -546,6 +663,16 @@ int main(int argc, char *argv[])
     std::cout << "TEST deleted object " << deleted_name << " after renamed existing object to it's ID: " << (!o4.is_deleted() ? "OK" : "FAILED") << std::endl;
     check_rename(o4, deleted_name);
 
+    check_indices(db, o1, o3, int32_value, "rename");
+
+    set_value(o3, "sint32", int32_value);
+    check_indices(db, o1, o3, int32_value, "set of subclass object");
+
+    db.abort();
+    db.get("Dummy", "#1", o1);  // the rename of #1 was aborted
+    db.get("Dummy", "#3", o3);
+    check_indices(db, o1, o3, int32_value, "abort");
+
     return 0;
   }
   catch (dunedaq::conffwk::Exception & ex) {
@@ -0,0 +1,233 @@
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include <filesystem>
+#include <iostream>
+#include <map>
+#include <set>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "conffwk/Configuration.hpp"
+#include "conffwk/ConfigObject.hpp"
+#include "conffwk/SnapshotCache.hpp"
+
+  // the SnapshotCache.hpp declares global ConfigObject class, so the names of conffwk are qualified
+
+namespace conffwk = dunedaq::conffwk;
+
+ERS_DECLARE_ISSUE(
+  conffwk_test_snapshot,
+  BadCommandLine,
+  "bad command line: " << reason,
+  ((const char*)reason)
+)
+
+ERS_DECLARE_ISSUE(
+  conffwk_test_snapshot,
+  ConfigException,
+  "caught dunedaq::conffwk::Exception exception",
+)
+
+static void
+usage()
+{
+  std::cout <<
+    "Usage: conffwk_test_snapshot -d data_name -p plugin_spec\n"
+    "\n"
+    "Options/Arguments:\n"
+    "       -d data_name      name of existing data file (e.g. created by conffwk_test_rw), it is modified by the test\n"
+    "       -p plugin_spec    conffwk plugin specification (oksconflibs)\n"
+    "\n"
+    "Description:\n"
+    "       The utility tests database snapshot cache (see TDAQ_DB_SNAPSHOT_CACHE).\n\n";
+}
+
+static void
+no_param(const char * s)
+{
+  std::ostringstream text;
+  text << "no parameter for " << s << " provided";
+  ers::fatal(conffwk_test_snapshot::BadCommandLine(ERS_HERE, text.str().c_str()));
+  exit(EXIT_FAILURE);
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+static bool
+is_snapshot_object(const conffwk::ConfigObject& o)
+{
+  return (dynamic_cast<const conffwk::SnapshotCacheObject *>(o.implementation()) != nullptr);
+}
+
+static void
+check_sint32(conffwk::ConfigObject& o, int32_t v1)
+{
+  int32_t v2;
+  o.get("sint32", v2);
+  std::cout << "TEST sint32 of " << o << ": " << (v1 == v2 ? "OK" : "FAILED") << std::endl;
+}
+
+
+// print attributes, relationships and referenced_by of all objects; return true, if they are read from snapshot
+
+static bool
+describe_objects(conffwk::Configuration& db, std::map<std::string, std::string>& result)
+{
+  std::vector<conffwk::ConfigObject> objs;
+  db.get("Dummy", objs);  // all objects of test are of Dummy class and of its subclasses
+
+  bool from_snapshot = !objs.empty();
+
+  for(auto& o : objs) {
+    if(!is_snapshot_object(o)) from_snapshot = false;
+
+    std::ostringstream s;
+    o.print_ref(s, db);
+
+    std::vector<conffwk::ConfigObject> refs;
+    o.referenced_by(refs, "*", false);
+
+    std::set<std::string> names;
+    for(auto& x : refs) names.insert(x.full_name());
+
+    s << "  referenced by:";
+    for(auto& x : names) s << ' ' << x;
+
+    result[o.full_name()] = s.str();
+  }
+
+  return from_snapshot;
+}
+
+static void
+check_snapshot_cache(const std::string& plugin_name, const std::string& data_name)
+{
+  const std::string dir(data_name + ".snapshots");
+  const std::string spec(plugin_name + ':' + data_name);
+
+  std::filesystem::remove_all(dir);  // remove snapshots of previous runs
+  std::filesystem::create_directory(dir);
+  ::setenv("TDAQ_DB_SNAPSHOT_CACHE", dir.c_str(), 1);
+
+  std::map<std::string, std::string> expected, found;
+
+  {
+    conffwk::Configuration db(spec);  // read by plug-in and write snapshot
+    const bool from_snapshot = describe_objects(db, expected);
+    std::cout << "TEST first load of " << expected.size() << " objects is done by plug-in: " << (from_snapshot ? "FAILED" : "OK") << std::endl;
+  }
+
+  if(std::filesystem::is_empty(dir)) {
+    std::cout << "TEST snapshot cache: SKIPPED (the snapshot was not written, database is not a file)" << std::endl;
+    ::unsetenv("TDAQ_DB_SNAPSHOT_CACHE");
+    return;
+  }
+
+  {
+    conffwk::Configuration db(spec);
+    const bool from_snapshot = describe_objects(db, found);
+    std::cout << "TEST second load is done from snapshot: " << (from_snapshot ? "OK" : "FAILED") << std::endl;
+    std::cout << "TEST attributes, relationships and referenced_by read from snapshot: " << (found == expected ? "OK" : "FAILED") << std::endl;
+
+    conffwk::ConfigObject o;
+    db.get("Dummy", "#1", o);
+
+    bool rejected = false;
+    try {
+      o.set_by_val("sint32", int32_t(12345));
+    }
+    catch (dunedaq::conffwk::Generic&) {
+      rejected = true;
+    }
+
+    std::cout << "TEST modification of object read from snapshot is rejected: " << (rejected ? "OK" : "FAILED") << std::endl;
+
+    db.leave_snapshot_cache();
+    o.set_by_val("sint32", int32_t(12345));
+
+    std::cout << "TEST modified object is read by plug-in: " << (is_snapshot_object(o) ? "FAILED" : "OK") << std::endl;
+    check_sint32(o, 12345);
+
+    found.clear();
+    describe_objects(db, found);
+    std::cout << "TEST objects after switch to plug-in: " << (found.size() == expected.size() ? "OK" : "FAILED") << std::endl;
+
+    db.commit("test application (conffwk/test/config_test_snapshot.cxx): modify database read from snapshot");
+  }
+
+  expected.clear();
+
+  {
+    conffwk::Configuration db(spec);  // the snapshot is stale, read by plug-in and write new snapshot
+    const bool from_snapshot = describe_objects(db, expected);
+    std::cout << "TEST stale snapshot is not used after modification of database file: " << (from_snapshot ? "FAILED" : "OK") << std::endl;
+  }
+
+  found.clear();
+
+  {
+    conffwk::Configuration db(spec);
+    const bool from_snapshot = describe_objects(db, found);
+    std::cout << "TEST rebuilt snapshot is used: " << (from_snapshot ? "OK" : "FAILED") << std::endl;
+    std::cout << "TEST objects read from rebuilt snapshot: " << (found == expected ? "OK" : "FAILED") << std::endl;
+
+    conffwk::ConfigObject o;
+    db.get("Dummy", "#1", o);
+    check_sint32(o, 12345);
+  }
+
+  ::unsetenv("TDAQ_DB_SNAPSHOT_CACHE");
+  std::filesystem::remove_all(dir);
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+int main(int argc, char *argv[])
+{
+  const char * data_name = 0;
+  const char * plugin_name = 0;
+
+  for(int i = 1; i < argc; i++) {
+    const char * cp = argv[i];
+
+    if(!strcmp(cp, "-h") || !strcmp(cp, "--help")) {
+      usage();
+      return 0;
+    }
+    else if(!strcmp(cp, "-d") || !strcmp(cp, "--data-name")) {
+      if(++i == argc) { no_param(cp); } else { data_name = argv[i]; }
+    }
+    else if(!strcmp(cp, "-p") || !strcmp(cp, "--plugin-spec")) {
+      if(++i == argc) { no_param(cp); } else { plugin_name = argv[i]; }
+    }
+    else {
+      std::ostringstream text;
+      text << "unexpected parameter: \'" << cp << "\'; run command with --help to see valid command line options.";
+      ers::fatal(conffwk_test_snapshot::BadCommandLine(ERS_HERE, text.str().c_str()));
+      return (EXIT_FAILURE);
+    }
+  }
+
+  if(!data_name) {
+    ers::fatal(conffwk_test_snapshot::BadCommandLine(ERS_HERE, "no data filename given"));
+    return (EXIT_FAILURE);
+  }
+
+  if(!plugin_name) {
+    ers::fatal(conffwk_test_snapshot::BadCommandLine(ERS_HERE, "no plugin specification given (oksconflibs)"));
+    return (EXIT_FAILURE);
+  }
+
+  try {
+    check_snapshot_cache(plugin_name, data_name);
+    return 0;
+  }
+  catch (dunedaq::conffwk::Exception & ex) {
+    ers::fatal(conffwk_test_snapshot::ConfigException(ERS_HERE, ex));
+  }
+
+  return (EXIT_FAILURE);
+}
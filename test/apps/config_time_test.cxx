@@ -1,15 +1,22 @@
 #include <stdlib.h>
 #include <time.h>
 #include <sys/resource.h>
+#include <unistd.h>
 
+#include <algorithm>
 #include <chrono>
+#include <filesystem>
 #include <iostream>
 #include <fstream>
 #include <string>
+#include <thread>
+#include <vector>
 
 #include "conffwk/Configuration.hpp"
 #include "conffwk/ConfigObject.hpp"
+#include "conffwk/DalFactory.hpp"
 #include "conffwk/Schema.hpp"
+#include "conffwk/Snapshot.hpp"
 
 using namespace dunedaq::conffwk;
 
@@ -26,6 +33,13 @@ ERS_DECLARE_ISSUE(
   "caught dunedaq::conffwk::Exception exception",
 )
 
+ERS_DECLARE_ISSUE(
+  conffwk_time_test,
+  BadSnapshot,
+  "bad snapshot: " << reason,
+  ((const char*)reason)
+)
+
 static void
 no_param(const char * s)
 {
@@ -42,21 +56,133 @@ stop_and_report(T& tp, const char * fname)
   std::cout << "TEST \"" << fname << "\" => " << std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now()-tp).count() / 1000. << " ms\n";
 }
 
+template <class T>
+void
+stop_and_report(T& tp, const char * fname, unsigned long count)
+{
+  const auto ns = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now()-tp).count();
+  std::cout << "TEST \"" << fname << "\" => " << ns / 1000000. << " ms (" << (count ? static_cast<double>(ns) / count : 0.) << " ns per lookup)\n";
+}
+
+  // generate database with given number of classes to measure cost of lookups, that does not depend on size of schema;
+  // each class derives from one of the previous classes, so the hierarchy is also deep; return database specification
+
+static std::string
+generate_database(const std::filesystem::path& dir, unsigned int num_of_classes, unsigned int num_of_objects)
+{
+  const std::string schema_name((dir / "classes.schema.xml").string());
+  const std::string data_name((dir / "classes.data.xml").string());
+
+  {
+    std::ofstream f(schema_name);
+
+    f <<
+      "<?xml version=\"1.0\" encoding=\"ASCII\"?>\n\n"
+      "<!-- oks-schema version 2.0 -->\n\n"
+      "<oks-schema>\n\n"
+      "<info name=\"\" type=\"\" num-of-includes=\"0\" num-of-items=\"" << num_of_classes << "\" oks-format=\"schema\" oks-version=\"conffwk_time_test\" created-by=\"conffwk_time_test\" created-on=\"localhost\" creation-time=\"20000101T000000\" last-modified-by=\"conffwk_time_test\" last-modified-on=\"localhost\" last-modification-time=\"20000101T000000\"/>\n\n";
+
+    for(unsigned int i = 0; i < num_of_classes; ++i) {
+      f << " <class name=\"Class" << i << "\">\n";
+      if(i) {
+        f << "  <superclass name=\"Class" << (i - 1) / 4 << "\"/>\n";
+      }
+      f << "  <attribute name=\"value" << i << "\" type=\"s32\" init-value=\"" << i << "\"/>\n";
+      f << " </class>\n\n";
+    }
+
+    f << "</oks-schema>\n";
+
+    if(!f) {
+      throw dunedaq::conffwk::Generic(ERS_HERE, ("cannot write schema file " + schema_name).c_str());
+    }
+  }
+
+  Configuration db("oksconflibs");
+
+  db.create(data_name, std::list<std::string>(1, schema_name));
+
+  for(unsigned int i = 0; i < num_of_classes; ++i) {
+    const std::string class_name("Class" + std::to_string(i));
+    for(unsigned int j = 0; j < num_of_objects; ++j) {
+      ConfigObject obj;
+      db.create(data_name, class_name, class_name + '-' + std::to_string(j), obj);
+    }
+  }
+
+  db.commit("conffwk_time_test: generate database");
+
+  return "oksconflibs:" + data_name;
+}
+
+  // read value of single-value or multi-value attribute
+
+template <class T>
+void
+read_value(ConfigObject& obj, const attribute_t& a)
+{
+  if(a.p_is_multi_value) {
+    std::vector<T> value;
+    obj.get(a.p_name, value);
+  }
+  else {
+    T value;
+    obj.get(a.p_name, value);
+  }
+}
+
+static void
+read_attributes(ConfigObject& obj, const class_t& d)
+{
+  for(const auto& a : d.p_attributes) {
+    switch(a.p_type) {
+      case bool_type:   read_value<bool>(obj, a);        break;
+      case s8_type:     read_value<int8_t>(obj, a);      break;
+      case u8_type:     read_value<uint8_t>(obj, a);     break;
+      case s16_type:    read_value<int16_t>(obj, a);     break;
+      case u16_type:    read_value<uint16_t>(obj, a);    break;
+      case s32_type:    read_value<int32_t>(obj, a);     break;
+      case u32_type:    read_value<uint32_t>(obj, a);    break;
+      case s64_type:    read_value<int64_t>(obj, a);     break;
+      case u64_type:    read_value<uint64_t>(obj, a);    break;
+      case float_type:  read_value<float>(obj, a);       break;
+      case double_type: read_value<double>(obj, a);      break;
+      default:          read_value<std::string>(obj, a); break;
+    }
+  }
+}
+
+  // converter doing nothing, to measure cost of converters call
+
+template <class T>
+class NopConverter : public Configuration::AttributeConverter<T> {
+  public:
+    void convert(T&, const Configuration&, const ConfigObject&, const std::string&) override {}
+};
+
 
 int main(int argc, char *argv[])
 {
   const char * db_name = 0;
+  unsigned int num_of_classes = 0;
+  unsigned int num_of_objects = 10;
   bool verbose = false;
+  unsigned long lookups = 10;
+  unsigned int threads = std::min(32U, std::thread::hardware_concurrency());
 
   for(int i = 1; i < argc; i++) {
     const char * cp = argv[i];
 
     if(!strcmp(cp, "-h") || !strcmp(cp, "--help")) {
       std::cout << 
-        "Usage: conffwk_time_test -d dbspec [-c | -C [class_name]] [-o | -O [object_id]] [-n]\n"
+        "Usage: conffwk_time_test -d dbspec | -g number [-n number] [-l number] [-t number] [-v]\n"
         "\n"
         "Options/Arguments:\n"
         "  -d | --database dbspec        database specification in format plugin-name:parameters\n"
+        "  -g | --generate number        generate database with number of classes (e.g. 500) in temporary directory using oksconflibs plug-in\n"
+        "  -n | --objects number         number of objects per class in generated database (default 10)\n"
+        "  -l | --lookups number         number of passes to get every object by class name and id (default 10)\n"
+        "  -t | --threads number         maximum number of threads getting objects by class name and id in parallel (default is number of CPUs, but not more than 32)\n"
         "  -v | --verbose                print details\n"
         "\n"
         "Description:\n"
@@ -66,24 +192,56 @@ int main(int argc, char *argv[])
     else if(!strcmp(cp, "-d") || !strcmp(cp, "--database")) {
       if(++i == argc) { no_param(cp); } else { db_name = argv[i]; }
     }
+    else if(!strcmp(cp, "-g") || !strcmp(cp, "--generate")) {
+      if(++i == argc) { no_param(cp); } else { num_of_classes = strtoul(argv[i], nullptr, 10); }
+    }
+    else if(!strcmp(cp, "-n") || !strcmp(cp, "--objects")) {
+      if(++i == argc) { no_param(cp); } else { num_of_objects = strtoul(argv[i], nullptr, 10); }
+    }
+    else if(!strcmp(cp, "-l") || !strcmp(cp, "--lookups")) {
+      if(++i == argc) { no_param(cp); } else { lookups = strtoul(argv[i], nullptr, 10); }
+    }
+    else if(!strcmp(cp, "-t") || !strcmp(cp, "--threads")) {
+      if(++i == argc) { no_param(cp); } else { threads = strtoul(argv[i], nullptr, 10); }
+    }
     else if(!strcmp(cp, "-v") || !strcmp(cp, "--verbose")) {
       verbose = true;
     }
   }
 
-  if(!db_name) {
-    ers::fatal(conffwk_time_test::BadCommandLine(ERS_HERE, "no database name given"));
+  if(!db_name && !num_of_classes) {
+    ers::fatal(conffwk_time_test::BadCommandLine(ERS_HERE, "no database name or number of classes to generate given"));
     return (EXIT_FAILURE);
   }
 
+  std::filesystem::path generated_dir;
+
   try {
   
+    ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+    std::string db_spec(db_name ? db_name : "");
+
+    if(num_of_classes) {
+      auto tp = std::chrono::steady_clock::now();
+
+      generated_dir = std::filesystem::temp_directory_path() / ("conffwk_time_test." + std::to_string(getpid()));
+      std::filesystem::create_directories(generated_dir);
+
+      db_spec = generate_database(generated_dir, num_of_classes, num_of_objects);
+
+      if(verbose) {
+        std::cout << "generated database \"" << db_spec << "\" with " << num_of_classes << " classes and " << num_of_objects << " objects per class" << std::endl;
+      }
+
+      stop_and_report(tp, "generating database");
+    }
     
     ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 
     auto tp = std::chrono::steady_clock::now();
 
-    Configuration conf(db_name);
+    Configuration conf(db_spec);
 
     if(verbose) {
       std::cout << "load database \"" << conf.get_impl_spec() << '\"' << std::endl;
@@ -186,11 +344,363 @@ int main(int argc, char *argv[])
 
     ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 
+      // all objects are in cache now, so this measures lookup of implementation objects by class name and id
+
+    std::vector<std::pair<std::string, std::string>> ids;
+    ids.reserve(all_objects.size());
+
+    for(const auto& i : all_objects) {
+      ids.emplace_back(i.class_name(), i.UID());
+    }
+
+    tp = std::chrono::steady_clock::now();
+
+    for(unsigned long i = 0; i < lookups; ++i) {
+      for(const auto& j : ids) {
+        ConfigObject obj;
+        conf.get(j.first, j.second, obj);
+      }
+    }
+
+    if(verbose) {
+      std::cout << "Made " << lookups * ids.size() << " lookups of " << ids.size() << " objects in " << classes.size() << " classes\n";
+    }
+
+    {
+      const std::string name = "getting objects by class name and id in " + std::to_string(classes.size()) + " classes";
+      stop_and_report(tp, name.c_str(), lookups * ids.size());
+    }
+
+      // the same lookups by name of base class of generated classes: the object is found via the index of subclasses
+
+    if(num_of_classes) {
+      tp = std::chrono::steady_clock::now();
+
+      for(unsigned long i = 0; i < lookups; ++i) {
+        for(const auto& j : ids) {
+          ConfigObject obj;
+          conf.get("Class0", j.second, obj);
+        }
+      }
+
+      const std::string name = "getting objects by id and base class of " + std::to_string(classes.size()) + " classes";
+      stop_and_report(tp, name.c_str(), lookups * ids.size());
+    }
+
+    ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+      // the same lookups shared by 1, 2, 4, ... threads: the time should decrease, unless the threads contend on locks
+
+    for(unsigned int n = 2; n <= threads && !ids.empty(); n = (n < threads && n * 2 > threads) ? threads : n * 2) {
+      tp = std::chrono::steady_clock::now();
+
+      std::vector<std::thread> workers;
+
+      for(unsigned int t = 0; t < n; ++t) {
+        workers.emplace_back([&conf, &ids, lookups, n, t]() {
+          try {
+            for(unsigned long i = t; i < lookups * ids.size(); i += n) {
+              const auto& j = ids[i % ids.size()];
+              ConfigObject obj;
+              conf.get(j.first, j.second, obj);
+            }
+          }
+          catch (dunedaq::conffwk::Exception & ex) {
+            ers::error(conffwk_time_test::ConfigException(ERS_HERE, ex));
+          }
+        });
+      }
+
+      for(auto& w : workers) {
+        w.join();
+      }
+
+      if(verbose) {
+        const auto us = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now()-tp).count();
+        std::cout << "Made " << lookups * ids.size() << " lookups in " << n << " threads (" << (us ? lookups * ids.size() * 1000000 / us : 0) << " lookups per second)\n";
+      }
+
+      const std::string name = "getting objects by class name and id in " + std::to_string(n) + " threads";
+      stop_and_report(tp, name.c_str());
+    }
+
+    ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+    tp = std::chrono::steady_clock::now();
+
+    std::shared_ptr<const ConfigurationSnapshot> snapshot = conf.snapshot();
+
+    if(verbose) {
+      std::cout << "The snapshot has " << snapshot->size() << " objects\n";
+    }
+
+    stop_and_report(tp, "making snapshot");
+
+    ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+      // the lookups in snapshot do not lock any mutex, so the time should decrease with number of threads
+
+    for(unsigned int n = 1; n <= threads && !ids.empty(); n = (n < threads && n * 2 > threads) ? threads : n * 2) {
+      tp = std::chrono::steady_clock::now();
+
+      std::vector<std::thread> workers;
+
+      for(unsigned int t = 0; t < n; ++t) {
+        workers.emplace_back([&snapshot, &ids, lookups, n, t]() {
+          for(unsigned long i = t; i < lookups * ids.size(); i += n) {
+            const auto& j = ids[i % ids.size()];
+            if(snapshot->get(j.first, j.second) == nullptr) {
+              std::ostringstream text;
+              text << "cannot find object \'" << j.second << '@' << j.first << '\'';
+              ers::error(conffwk_time_test::BadSnapshot(ERS_HERE, text.str().c_str()));
+            }
+          }
+        });
+      }
+
+      for(auto& w : workers) {
+        w.join();
+      }
+
+      if(verbose) {
+        const auto us = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now()-tp).count();
+        std::cout << "Made " << lookups * ids.size() << " snapshot lookups in " << n << " threads (" << (us ? lookups * ids.size() * 1000000 / us : 0) << " lookups per second)\n";
+      }
+
+      const std::string name = "getting snapshot objects by class name and id in " + std::to_string(n) + " threads";
+      stop_and_report(tp, name.c_str());
+    }
+
+    snapshot.reset();
+
+    ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+    tp = std::chrono::steady_clock::now();
+
+    std::size_t cached_bytes = 0;
+
+    for(const auto& i : conf.memory_usage()) {
+      cached_bytes += i.second.total_bytes();
+      if(verbose) {
+        std::cout << "Class " << i.first << " has " << i.second.p_impl_objects << " cached objects of " << i.second.total_bytes() << " bytes\n";
+      }
+    }
+
+    if(verbose) {
+      std::cout << "Total size of cached objects: " << cached_bytes << " bytes\n";
+    }
+
+    stop_and_report(tp, "getting memory usage");
+
+    ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+    tp = std::chrono::steady_clock::now();
+
+    conf.unread_all_objects(true);
+
+    stop_and_report(tp, "unreading all objects");
+
+    tp = std::chrono::steady_clock::now();
+
+    {
+      std::ofstream null("/dev/null", std::ios::out);
+      for(const auto& i : all_objects) {
+        i.print_ref(null, conf);
+      }
+    }
+
+    stop_and_report(tp, "re-reading all attributes and relationships");
+
+    ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+      // stress of parallel resolution of relationships: after unread each object is re-read by all threads at once,
+      // so the plug-in concurrently updates and inserts the same implementation objects
+
+    for(unsigned int n = 2; n <= threads && !all_objects.empty(); n = (n < threads && n * 2 > threads) ? threads : n * 2) {
+      tp = std::chrono::steady_clock::now();
+
+      for(unsigned long i = 0; i < lookups; ++i) {
+        conf.unread_all_objects(true);
+
+        std::vector<std::thread> workers;
+
+        for(unsigned int t = 0; t < n; ++t) {
+          workers.emplace_back([&conf, &all_objects]() {
+            try {
+              std::ofstream null("/dev/null", std::ios::out);
+              for(const auto& j : all_objects) {
+                j.print_ref(null, conf);
+              }
+            }
+            catch (dunedaq::conffwk::Exception & ex) {
+              ers::error(conffwk_time_test::ConfigException(ERS_HERE, ex));
+            }
+          });
+        }
+
+        for(auto& w : workers) {
+          w.join();
+        }
+      }
+
+      const std::string name = "re-reading all attributes and relationships " + std::to_string(lookups) + " times by " + std::to_string(n) + " threads at once";
+      stop_and_report(tp, name.c_str());
+    }
+
+    ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+      // stress of parallel initialization of template objects of classes with DAL classes registered by linked libraries
+
+    std::vector<std::string> dal_classes;
+
+    for(const auto& i : classes) {
+      try {
+        DalFactory::instance().functions(conf, i, false);
+        dal_classes.push_back(i);
+      }
+      catch (dunedaq::conffwk::Exception &) {
+        ;
+      }
+    }
+
+    for(unsigned int n = 1; n <= threads && !dal_classes.empty(); n = (n < threads && n * 2 > threads) ? threads : n * 2) {
+      tp = std::chrono::steady_clock::now();
+
+      std::size_t count = 0;
+      double init_time = 0;
+
+      for(unsigned long i = 0; i < lookups; ++i) {
+        conf.unread_all_objects(true);
+
+        for(const auto& j : conf.warmup(dal_classes, n)) {
+          count += j.second.p_objects;
+          init_time += j.second.p_init_time;
+        }
+      }
+
+      if(verbose) {
+        std::cout << "Warmed up " << count << " template objects of " << dal_classes.size() << " classes by " << n << " threads (initialization took " << init_time << " seconds summed over threads)\n";
+      }
+
+      const std::string name = "warming up template objects " + std::to_string(lookups) + " times by " + std::to_string(n) + " threads";
+      stop_and_report(tp, name.c_str());
+    }
+
+    ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+      // the template objects are in cache now, so get<T>() and find<T>() are hits taking shared lock on template objects:
+      // the time should decrease with number of threads, unless the readers contend on the lock
+
+    std::vector<std::pair<const DalFactoryFunctions *, std::string>> dal_ids;
+
+    for(const auto& i : ids) {
+      if(std::find(dal_classes.begin(), dal_classes.end(), i.first) != dal_classes.end()) {
+        dal_ids.emplace_back(&DalFactory::instance().functions(conf, i.first, false), i.second);
+      }
+    }
+
+    for(unsigned int n = 1; n <= threads && !dal_ids.empty(); n = (n < threads && n * 2 > threads) ? threads : n * 2) {
+      tp = std::chrono::steady_clock::now();
+
+      std::vector<std::thread> workers;
+
+      for(unsigned int t = 0; t < n; ++t) {
+        workers.emplace_back([&conf, &dal_ids, lookups, n, t]() {
+          try {
+            for(unsigned long i = t; i < lookups * dal_ids.size(); i += n) {
+              const auto& j = dal_ids[i % dal_ids.size()];
+              if((*j.first->m_get_fn)(conf, j.second) == nullptr || (*j.first->m_find_fn)(conf, j.second) == nullptr) {
+                std::cerr << "ERROR: cannot find template object \'" << j.second << "\'\n";
+              }
+            }
+          }
+          catch (dunedaq::conffwk::Exception & ex) {
+            ers::error(conffwk_time_test::ConfigException(ERS_HERE, ex));
+          }
+        });
+      }
+
+      for(auto& w : workers) {
+        w.join();
+      }
+
+      if(verbose) {
+        const auto us = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now()-tp).count();
+        std::cout << "Made " << lookups * dal_ids.size() * 2 << " get<T>() and find<T>() lookups of " << dal_ids.size() << " template objects in " << n << " threads (" << (us ? lookups * dal_ids.size() * 2 * 1000000 / us : 0) << " lookups per second)\n";
+      }
+
+      const std::string name = "getting and finding template objects by id in " + std::to_string(n) + " threads";
+      stop_and_report(tp, name.c_str());
+    }
+
+    ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+      // all objects are in cache now, so this measures reading of attribute values and their conversion
+
+    for(int with_converters = 0; with_converters < 2; ++with_converters) {
+      if(with_converters) {
+        conf.register_converter(new NopConverter<bool>());
+        conf.register_converter(new NopConverter<int8_t>());
+        conf.register_converter(new NopConverter<uint8_t>());
+        conf.register_converter(new NopConverter<int16_t>());
+        conf.register_converter(new NopConverter<uint16_t>());
+        conf.register_converter(new NopConverter<int32_t>());
+        conf.register_converter(new NopConverter<uint32_t>());
+        conf.register_converter(new NopConverter<int64_t>());
+        conf.register_converter(new NopConverter<uint64_t>());
+        conf.register_converter(new NopConverter<float>());
+        conf.register_converter(new NopConverter<double>());
+        conf.register_converter(new NopConverter<std::string>());
+      }
+
+      tp = std::chrono::steady_clock::now();
+
+      for(unsigned long i = 0; i < lookups; ++i) {
+        for(auto& j : all_objects) {
+          read_attributes(j, conf.get_class_info(j.class_name()));
+        }
+      }
+
+      stop_and_report(tp, with_converters ? "reading attributes with converters" : "reading attributes without converters");
+
+      tp = std::chrono::steady_clock::now();
+
+      std::vector<attribute_value_t> values;
+
+      for(unsigned long i = 0; i < lookups; ++i) {
+        for(auto& j : all_objects) {
+          j.get_all(values);
+        }
+      }
+
+      stop_and_report(tp, with_converters ? "reading all attributes in batch with converters" : "reading all attributes in batch without converters");
+    }
+
+    ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+    all_objects.clear();
+
+    tp = std::chrono::steady_clock::now();
+
+    conf.unload();
+
+    stop_and_report(tp, "unloading database");
+
+    ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+    if(!generated_dir.empty()) {
+      std::filesystem::remove_all(generated_dir);
+    }
+
     return 0;
   }
   catch (dunedaq::conffwk::Exception & ex) {
     ers::fatal(conffwk_time_test::ConfigException(ERS_HERE, ex));
   }
 
+  if(!generated_dir.empty()) {
+    std::filesystem::remove_all(generated_dir);
+  }
+
   return (EXIT_FAILURE);
 }